@@ -0,0 +1,97 @@
+#include "adjacency.h"
+#include "trace.h"
+
+#include <algorithm>
+
+HybridAdjacency::HybridAdjacency(std::vector<std::vector<int>> const& adj_list, size_t dense_divisor)
+    : n(adj_list.size()), words((adj_list.size() + 63) / 64) {
+    size_t threshold = n / dense_divisor;
+    dense_row.assign(n, -1);
+    offsets.reserve(n + 1);
+    offsets.push_back(0);
+    for(size_t v = 0; v < n; v++){
+        if(adj_list[v].size() > threshold){
+            dense_row[v] = bitmaps.size() / words;
+            bitmaps.resize(bitmaps.size() + words, 0);
+            uint64_t *row = bitmaps.data() + dense_row[v] * words;
+            for(int j : adj_list[v]){
+                row[j >> 6] |= uint64_t(1) << (j & 63);
+            }
+        } else {
+            targets.insert(targets.end(), adj_list[v].begin(), adj_list[v].end());
+        }
+        offsets.push_back(targets.size());
+    }
+    targets.shrink_to_fit();
+}
+
+std::vector<bool> HybridAdjacency::reach_from(std::vector<int> const& starting_indices, std::vector<bool> const* within) const {
+    PRISL_TRACE_SCOPE("slice", "slice query");
+    std::vector<uint64_t> visited(words, 0);
+    std::vector<uint64_t> next(words, 0);
+    std::vector<uint64_t> allowed(words, ~uint64_t(0));
+    if(within != nullptr){
+        std::fill(allowed.begin(), allowed.end(), 0);
+        for(size_t v = 0; v < n; v++){
+            if(within->at(v)){ allowed[v >> 6] |= uint64_t(1) << (v & 63);}
+        }
+    }
+
+    std::vector<int> frontier;
+    for(int s : starting_indices){
+        uint64_t bit = uint64_t(1) << (s & 63);
+        if(!(allowed[s >> 6] & bit) || (visited[s >> 6] & bit)){ continue;}
+        visited[s >> 6] |= bit;
+        frontier.push_back(s);
+    }
+    while(!frontier.empty()){
+        std::fill(next.begin(), next.end(), 0);
+        for(int v : frontier){
+            if(dense_row[v] >= 0){
+                // plain word loop, vectorized by the compiler in Release builds (the default build type)
+                uint64_t const *row = bitmaps.data() + dense_row[v] * words;
+                for(size_t w = 0; w < words; w++){
+                    next[w] |= row[w];
+                }
+            } else {
+                for(uint32_t k = offsets[v]; k < offsets[v + 1]; k++){
+                    next[targets[k] >> 6] |= uint64_t(1) << (targets[k] & 63);
+                }
+            }
+        }
+        frontier.clear();
+        for(size_t w = 0; w < words; w++){
+            uint64_t fresh = next[w] & ~visited[w] & allowed[w];
+            visited[w] |= fresh;
+            while(fresh != 0){
+                frontier.push_back(w * 64 + __builtin_ctzll(fresh));
+                fresh &= fresh - 1;
+            }
+        }
+    }
+
+    std::vector<bool> reached(n, false);
+    for(size_t v = 0; v < n; v++){
+        reached[v] = (visited[v >> 6] >> (v & 63)) & 1;
+    }
+    return reached;
+}
+
+std::vector<int> HybridAdjacency::row(int v) const {
+    if(dense_row[v] < 0){
+        return std::vector<int>(targets.begin() + offsets[v], targets.begin() + offsets[v + 1]);
+    }
+    std::vector<int> row_targets;
+    uint64_t const *row = bitmaps.data() + dense_row[v] * words;
+    for(size_t w = 0; w < words; w++){
+        for(uint64_t bits = row[w]; bits != 0; bits &= bits - 1){
+            row_targets.push_back(w * 64 + __builtin_ctzll(bits));
+        }
+    }
+    return row_targets;
+}
+
+size_t HybridAdjacency::bytes() const {
+    return dense_row.capacity() * sizeof(int) + bitmaps.capacity() * sizeof(uint64_t)
+         + offsets.capacity() * sizeof(uint32_t) + targets.capacity() * sizeof(int);
+}
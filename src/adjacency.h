@@ -0,0 +1,34 @@
+#pragma once
+
+// component graph with a representation per row: rows of hubs (formulas, globals) that reach a large part of the
+// graph are bitmaps, all other rows stay index lists
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class HybridAdjacency {
+public:
+    // a row becomes a bitmap when it has more than n / dense_divisor edges, from there the bitmap of n bits is not
+    // larger than the list of 32 bit indices
+    explicit HybridAdjacency(std::vector<std::vector<int>> const& adj_list, size_t dense_divisor = 32);
+
+    // same as reach_from on the adjacency lists. Level by level: the bitmaps of the dense rows of a level are ORed
+    // into the next frontier a word at a time, the sparse rows set their bits one by one
+    std::vector<bool> reach_from(std::vector<int> const& starting_indices, std::vector<bool> const* within = nullptr) const;
+
+    // the targets of v, as in the adjacency lists it was built from (bitmap rows in increasing order)
+    std::vector<int> row(int v) const;
+
+    size_t size() const { return n;}
+    size_t dense_rows() const { return bitmaps.size() / (words == 0 ? 1 : words);}
+    size_t bytes() const;
+
+private:
+    size_t n = 0;
+    size_t words = 0; // 64 bit words per bitmap row
+    std::vector<int> dense_row; // vertex -> row in bitmaps, -1 for a sparse row
+    std::vector<uint64_t> bitmaps; // dense rows, words each
+    std::vector<uint32_t> offsets; // sparse rows as CSR: targets[offsets[v]..offsets[v+1]]
+    std::vector<int> targets;
+};
@@ -0,0 +1,453 @@
+#include "benchmark.h"
+#include "memory.h"
+#include "slicer.h"
+#include "trace.h"
+
+#include <storm-parsers/parser/PrismParser.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+// replaces whole identifiers in a code segment
+std::string rename_identifiers(std::string_view code, std::unordered_map<std::string, std::string> const& renaming){
+    std::string renamed;
+    size_t k = 0;
+    while(k < code.size()){
+        if(std::isalpha(static_cast<unsigned char>(code[k])) || code[k] == '_'){
+            size_t begin = k;
+            while(k < code.size() && (std::isalnum(static_cast<unsigned char>(code[k])) || code[k] == '_')){ k++;}
+            std::string identifier(code.substr(begin, k - begin));
+            std::unordered_map<std::string, std::string>::const_iterator it = renaming.find(identifier);
+            renamed += it == renaming.end() ? identifier : it->second;
+        } else {
+            renamed += code[k++];
+        }
+    }
+    return renamed;
+}
+
+// the vertices of a module with its variables and actions replaced by placeholders in order of appearance,
+// equal for modules that only differ by renaming
+std::string canonical_module_text(storm::prism::Module const& module, Vertices const& vertices, std::vector<int> const& module_vertices,
+                                  std::unordered_map< uint_fast64_t, std::string> &cid_to_action){
+    std::unordered_map<std::string, std::string> renaming;
+    for(storm::prism::BooleanVariable const& var : module.getBooleanVariables()){
+        renaming.emplace(var.getName(), "$v" + std::to_string(renaming.size()));
+    }
+    for(storm::prism::IntegerVariable const& var : module.getIntegerVariables()){
+        renaming.emplace(var.getName(), "$v" + std::to_string(renaming.size()));
+    }
+    std::unordered_map<std::string, std::string> action_renaming;
+    std::string text;
+    for(int v : module_vertices){
+        BetterNode const& node = vertices.at(v);
+        text += node.type;
+        text += "|";
+        if(node.type == "guard"){
+            std::string const& action = cid_to_action[node.identifier];
+            if(!action.empty()){
+                action_renaming.emplace(action, "$a" + std::to_string(action_renaming.size()));
+                text += action_renaming.at(action);
+            }
+            text += "|";
+        }
+        text += rename_identifiers(node.code_segment(), renaming);
+        text += "\n";
+    }
+    return text;
+}
+
+// true if swapping the vertices of copy and representative maps the adjacency onto itself (rows are ascending)
+bool is_automorphism(std::vector<std::vector<int>> const& adj_list, ModuleCopy const& copy){
+    std::vector<int> permutation(adj_list.size());
+    for(int v = 0; v < permutation.size(); v++){ permutation[v] = v;}
+    for(int k = 0; k < copy.copy_vertices.size(); k++){
+        permutation[copy.copy_vertices[k]] = copy.representative_vertices[k];
+        permutation[copy.representative_vertices[k]] = copy.copy_vertices[k];
+    }
+    std::vector<int> image;
+    for(int u = 0; u < adj_list.size(); u++){
+        image.clear();
+        for(int w : adj_list[u]){ image.push_back(permutation[w]);}
+        std::sort(image.begin(), image.end());
+        std::vector<int> target = adj_list[permutation[u]];
+        std::sort(target.begin(), target.end());
+        if(image != target){ return false;}
+    }
+    return true;
+}
+
+std::vector<ModuleCopy> find_module_copies(Vertices const& vertices, std::vector<std::vector<int>> const& adj_list,
+                                           storm::prism::Program const& program){
+    std::unordered_map< uint_fast64_t, std::string> cid_to_action = program.buildCommandIndexToActionNameMap();
+    VertexIndex module_index = build_module_index(vertices);
+    std::unordered_map<std::string, std::string> representative_by_text;
+    std::vector<ModuleCopy> copies;
+    for(storm::prism::Module const& module : program.getModules()){
+        VertexIndex::iterator it = module_index.find(module.getName());
+        if(it == module_index.end()){ continue;}
+        std::string text = canonical_module_text(module, vertices, it->second, cid_to_action);
+        std::unordered_map<std::string, std::string>::iterator rep = representative_by_text.find(text);
+        if(rep == representative_by_text.end()){
+            representative_by_text.emplace(text, module.getName());
+            continue;
+        }
+        ModuleCopy copy;
+        copy.representative_vertices = module_index.at(rep->second);
+        copy.copy_vertices = it->second;
+        if(is_automorphism(adj_list, copy)){
+            copies.push_back(std::move(copy));
+        }
+    }
+    return copies;
+}
+
+std::vector<bool> map_through_copy(std::vector<bool> const& visited, ModuleCopy const& copy){
+    std::vector<bool> mapped = visited;
+    for(int k = 0; k < copy.copy_vertices.size(); k++){
+        mapped[copy.copy_vertices[k]] = visited[copy.representative_vertices[k]];
+        mapped[copy.representative_vertices[k]] = visited[copy.copy_vertices[k]];
+    }
+    return mapped;
+}
+
+uint64_t hash_slice(std::vector<bool> const& visited){
+    uint64_t hash = 14695981039346656037ull;
+    for(int comp = 0; comp < visited.size(); comp++){
+        if(visited[comp]){
+            for(int shift = 0; shift < 32; shift += 8){
+                hash ^= (static_cast<uint32_t>(comp) >> shift) & 0xff;
+                hash *= 1099511628211ull;
+            }
+        }
+    }
+    return hash;
+}
+
+// the benchmark on the graph in program order, slice_of gives the visited vertices of one criterion
+Result benchmark_slices(Vertices const& vertices,
+                        std::vector<std::vector<int>> const& adj_list,
+                        storm::prism::Program const& program,
+                        VertexIndex const& code_index,
+                        std::function<std::vector<bool>(int)> const& slice_of,
+                        bool verbose,
+                        bool symmetry){
+    Result res;
+    if(verbose){ std::cout << "\n\nStarting COMPONENTS Benchmark\n\n";}
+    res.nodes = vertices.size();
+    res.edges = 0;
+    res.avg_size_uw = 0;
+    res.avg_size_w = 0;
+    res.slices_hash = 0;
+
+    for(std::vector<int> adj_vector : adj_list){
+        res.edges += adj_vector.size();
+    }
+    res.slices = 0;
+
+    //vector of slice sizes to calculate avg slice size
+    int slice_sizes;
+
+
+    std::map<int, std::vector<std::vector<bool>>> size_by_slices;
+    std::map<int, int> size_by_crits;
+
+
+    // with symmetry, vertices of module copies take the slice of their representative vertex through the renaming,
+    // if both are their own first match (otherwise the criterion starts elsewhere)
+    std::vector<ModuleCopy> copies;
+    std::vector<int> copy_of(vertices.size(), -1);
+    std::vector<int> representative_of(vertices.size(), -1);
+    std::unordered_map<int, std::vector<bool>> representative_slices;
+    int mapped_slices = 0;
+    if(symmetry){
+        copies = find_module_copies(vertices, adj_list, program);
+        for(int c = 0; c < copies.size(); c++){
+            for(int k = 0; k < copies[c].copy_vertices.size(); k++){
+                copy_of[copies[c].copy_vertices[k]] = c;
+                representative_of[copies[c].copy_vertices[k]] = copies[c].representative_vertices[k];
+                representative_slices.emplace(copies[c].representative_vertices[k], std::vector<bool>());
+            }
+        }
+    }
+
+    for(int index = 0; index < vertices.size(); index++ ){
+        std::vector<int> crit;
+        crit.push_back(code_index.at(std::string(vertices.at(index).code_segment())).front());
+        std::vector<bool> visited;
+        int representative = representative_of[index];
+        if(representative >= 0 && crit.front() == index
+           && code_index.at(std::string(vertices.at(representative).code_segment())).front() == representative){
+            visited = map_through_copy(representative_slices.at(representative), copies.at(copy_of[index]));
+            mapped_slices += 1;
+        } else {
+            visited = slice_of(crit.front());
+        }
+        std::unordered_map<int, std::vector<bool>>::iterator rep_slice = representative_slices.find(index);
+        if(rep_slice != representative_slices.end()){
+            rep_slice->second = visited;
+        }
+        int slice_size = std::count(visited.begin(), visited.end(), true);
+        std::map<int, std::vector<std::vector<bool>>>::iterator map_it = size_by_slices.find(slice_size);
+        if(map_it != size_by_slices.end()){
+            size_by_crits[map_it->first] += 1;
+            bool found = false;
+            std::vector<std::vector<bool>> visits_with_same_size = size_by_slices[map_it->first];
+            for(std::vector<bool> visits : visits_with_same_size){
+                bool equal=true;
+                for(int comp = 0; comp < visits.size(); comp++){
+                    if(visits.at(comp) != visited.at(comp)){
+                        equal = false;
+                        break;
+                    }
+                }
+                if(equal){
+                    found=true;
+                    break;
+                }
+            }
+            if(!found){
+                size_by_slices[map_it->first].push_back(visited);
+            }
+        } else {
+            std::vector<std::vector<bool>> new_visits;
+            new_visits.push_back(visited);
+            size_by_slices.insert(std::make_pair(slice_size, new_visits));
+            if(verbose){ std::cout<< "new length " << slice_size << " for slice of component: " << vertices.at(index).code_segment() << std::endl;}
+            size_by_crits.insert(std::make_pair(slice_size, 1));
+        }
+    }
+
+    if(verbose && symmetry){
+        std::cout << "symmetry: " << copies.size() << " module copies, " << mapped_slices << " slices mapped from their representatives\n";
+    }
+
+    int amount_unique_slices = 0;
+    int avg_slice_size = 0;
+    float size_by_unique_sum = 0;
+    float size_by_crits_sum = 0;
+    if(verbose){ std::cout << std::endl;}
+    for(std::pair<int, std::vector<std::vector<bool>>> x : size_by_slices) {
+        size_by_unique_sum += x.first * x.second.size();
+        size_by_crits_sum += x.first * size_by_crits[x.first];
+        amount_unique_slices += x.second.size();
+        avg_slice_size += (x.first * x.second.size());
+        for(std::vector<bool> const& visits : x.second){
+            res.slices_hash += hash_slice(visits);
+        }
+        if(!verbose){ continue;}
+        std::cout << "got " << x.second.size() << " unique slices with length: " << x.first;
+        std::cout << " produced by " << size_by_crits[x.first] << "/" << vertices.size() << " = " <<static_cast<float>(size_by_crits[x.first])/static_cast<float>(vertices.size()) << " percent of all components" << std::endl;
+
+ 
+    }
+
+
+    res.slices = amount_unique_slices;
+    res.slice_store_bytes = slice_store_bytes(size_by_slices);
+    if(amount_unique_slices != 0){
+        res.avg_size_uw = (size_by_unique_sum/static_cast<float>(amount_unique_slices));
+        res.avg_size_w = size_by_crits_sum / static_cast<float>(vertices.size());
+    }
+
+    
+    // print and test 
+    if(verbose){ res.print();}
+
+    return res;
+}
+
+Result benchmark(Vertices const& vertices,
+                 std::vector<std::vector<int>> const& adj_list,
+                  storm::prism::Program const& program,
+                  bool verbose,
+                  bool symmetry){
+    // a component criterion starts at the first component with the same code segment
+    return benchmark_slices(vertices, adj_list, program, build_code_index(vertices), [&](int crit){
+        return slice_cdg_benchmark(vertices, adj_list, {crit}, program);
+    }, verbose, symmetry);
+}
+
+Result benchmark(Slicer const& slicer, bool verbose, bool symmetry){
+    return benchmark_slices(slicer.vertices(), slicer.program_adj_list(), slicer.program(), slicer.code_index(), [&slicer](int crit){
+        return slicer.slice({crit}).visited;
+    }, verbose, symmetry);
+}
+
+CorpusEntry run_corpus_model(std::filesystem::path const& path, bool smt){
+    CorpusEntry entry;
+    entry.model = path.filename().string();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    PRISL_TRACE_BEGIN(parse_span, "parse", "parse", entry.model);
+    storm::prism::Program program = storm::parser::PrismParser::parse(path.string());
+    PRISL_TRACE_END(parse_span);
+    Vertices vertices = build_vertices_for_program(program);
+    std::unique_ptr<SyncPruner> pruner;
+    if(smt){
+        pruner = std::make_unique<SyncPruner>(program);
+    }
+    std::vector<std::vector<int>> adj_list = build_comp_adj_list(vertices, program, pruner.get());
+    entry.build_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    Result res = benchmark(vertices, adj_list, program, false);
+    entry.slicing_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    entry.nodes = res.nodes;
+    entry.edges = res.edges;
+    entry.slices = res.slices;
+    entry.slices_hash = res.slices_hash;
+    entry.has_slices_hash = true;
+    return entry;
+}
+
+std::map<std::string, CorpusEntry> read_corpus_baseline(std::string const& path){
+    std::map<std::string, CorpusEntry> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while(std::getline(file, line)){
+        if(line.empty() || line.front() == '#'){ continue;}
+        std::istringstream fields(line);
+        CorpusEntry entry;
+        std::string nodes, edges, slices, slices_hash, build_seconds, slicing_seconds;
+        if(!(fields >> entry.model >> nodes >> edges >> slices >> slices_hash >> build_seconds >> slicing_seconds)){
+            throw std::invalid_argument( "malformed line in baseline file: " + line );
+        }
+        // '-' keeps the 'not recorded' default
+        if(nodes != "-"){ entry.nodes = std::stoi(nodes);}
+        if(edges != "-"){ entry.edges = std::stoi(edges);}
+        if(slices != "-"){ entry.slices = std::stoi(slices);}
+        if(slices_hash != "-"){
+            entry.slices_hash = std::stoull(slices_hash, nullptr, 16);
+            entry.has_slices_hash = true;
+        }
+        if(build_seconds != "-"){ entry.build_seconds = std::stod(build_seconds);}
+        if(slicing_seconds != "-"){ entry.slicing_seconds = std::stod(slicing_seconds);}
+        baseline[entry.model] = entry;
+    }
+    return baseline;
+}
+
+void write_corpus_baseline(std::string const& path, std::vector<CorpusEntry> const& entries){
+    std::ofstream file(path);
+    if(!file.is_open()){
+        throw std::invalid_argument( "Unable to open baseline file" );
+    }
+    file << "# model nodes edges slices slices_hash build_seconds slicing_seconds\n";
+    for(CorpusEntry const& entry : entries){
+        file << entry.model << " " << entry.nodes << " " << entry.edges << " " << entry.slices << " "
+             << std::hex << entry.slices_hash << std::dec << " " << entry.build_seconds << " " << entry.slicing_seconds << "\n";
+    }
+}
+
+std::vector<std::filesystem::path> model_files(std::string const& dir){
+    std::vector<std::filesystem::path> models;
+    for(std::filesystem::directory_entry const& file : std::filesystem::directory_iterator(dir)){
+        std::string extension = file.path().extension().string();
+        if(file.is_regular_file() && (extension == ".prism" || extension == ".pm" || extension == ".nm" || extension == ".sm")){
+            models.push_back(file.path());
+        }
+    }
+    std::sort(models.begin(), models.end());
+    return models;
+}
+
+// a recorded count of the baseline that differs, -1 is not recorded
+bool count_changed(int base, int current){
+    return base >= 0 && base != current;
+}
+
+std::string recorded(int count){
+    return count >= 0 ? std::to_string(count) : std::string("-");
+}
+
+int run_corpus(std::string const& dir, std::string const& baseline_path, double threshold, bool write_baseline, bool smt){
+    // a CI run without a baseline would compare nothing and pass
+    if(!write_baseline && !std::filesystem::exists(baseline_path)){
+        throw std::invalid_argument( "baseline file " + baseline_path + " does not exist, write it with --write-baseline" );
+    }
+    std::vector<std::filesystem::path> models = model_files(dir);
+
+    int failures = 0;
+    std::vector<CorpusEntry> entries;
+    std::vector<std::string> failed; // models that could not be parsed or built
+    for(std::filesystem::path const& model : models){
+        try {
+            entries.push_back(run_corpus_model(model, smt));
+        } catch(std::exception const& e){
+            std::cout << "FAILED " << model.filename().string() << ": " << e.what() << std::endl;
+            failed.push_back(model.filename().string());
+            failures += 1;
+            continue;
+        }
+        CorpusEntry const& entry = entries.back();
+        std::cout << entry.model << ": " << entry.nodes << " nodes, " << entry.edges << " edges, " << entry.slices << " slices, "
+                  << "building " << entry.build_seconds << "s, slicing " << entry.slicing_seconds << "s" << std::endl;
+    }
+
+    if(write_baseline){
+        write_corpus_baseline(baseline_path, entries);
+        std::cout << "wrote baseline " << baseline_path << std::endl;
+        return failures;
+    }
+
+    const double noise_seconds = 0.01;
+    std::map<std::string, CorpusEntry> baseline = read_corpus_baseline(baseline_path);
+    for(std::string const& model : failed){
+        baseline.erase(model); // already counted, not missing as well
+    }
+    for(CorpusEntry const& entry : entries){
+        std::map<std::string, CorpusEntry>::iterator it = baseline.find(entry.model);
+        if(it == baseline.end()){
+            std::cout << "NEW " << entry.model << ": not in baseline" << std::endl;
+            continue;
+        }
+        CorpusEntry const& base = it->second;
+        // a value that is not recorded is not compared, the model would pass whatever changed
+        std::string unrecorded;
+        if(base.nodes < 0){ unrecorded += " nodes";}
+        if(base.edges < 0){ unrecorded += " edges";}
+        if(base.slices < 0){ unrecorded += " slices";}
+        if(!base.has_slices_hash){ unrecorded += " slices_hash";}
+        if(base.build_seconds < 0){ unrecorded += " build_seconds";}
+        if(base.slicing_seconds < 0){ unrecorded += " slicing_seconds";}
+        if(!unrecorded.empty()){
+            std::cout << "UNRECORDED " << entry.model << ":" << unrecorded << " not in the baseline, record them with --write-baseline" << std::endl;
+            failures += 1;
+        }
+        bool slices_differ = base.has_slices_hash && entry.slices_hash != base.slices_hash;
+        if(count_changed(base.nodes, entry.nodes) || count_changed(base.edges, entry.edges) || count_changed(base.slices, entry.slices)
+           || slices_differ){
+            std::cout << "CHANGED " << entry.model << ": " << recorded(base.nodes) << "/" << recorded(base.edges) << "/" << recorded(base.slices)
+                      << " -> " << entry.nodes << "/" << entry.edges << "/" << entry.slices << " nodes/edges/slices";
+            if(slices_differ){ std::cout << ", slices differ";}
+            std::cout << std::endl;
+            failures += 1;
+        }
+        if(base.build_seconds >= 0 && entry.build_seconds > base.build_seconds * (1 + threshold)
+           && entry.build_seconds - base.build_seconds > noise_seconds){
+            std::cout << "SLOWER " << entry.model << ": building " << base.build_seconds << "s -> " << entry.build_seconds << "s" << std::endl;
+            failures += 1;
+        }
+        if(base.slicing_seconds >= 0 && entry.slicing_seconds > base.slicing_seconds * (1 + threshold)
+           && entry.slicing_seconds - base.slicing_seconds > noise_seconds){
+            std::cout << "SLOWER " << entry.model << ": slicing " << base.slicing_seconds << "s -> " << entry.slicing_seconds << "s" << std::endl;
+            failures += 1;
+        }
+        baseline.erase(it);
+    }
+    for(std::pair<const std::string, CorpusEntry> const& missing : baseline){
+        std::cout << "MISSING " << missing.first << ": in baseline but not in " << dir << std::endl;
+        failures += 1;
+    }
+    std::cout << failures << " regressions against " << baseline_path << std::endl;
+    return failures;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+// benchmarks over all single component criteria and the corpus regression runner
+
+#include "graph.h"
+#include "slicer.h"
+
+#include <filesystem> // corpus directories
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+struct Result {
+    int nodes;
+    int edges;
+    int slices;
+    float avg_size_w;
+    float avg_size_uw;
+    size_t slice_store_bytes; // bytes held by the unique slices
+    uint64_t slices_hash; // order independent hash of the unique slices, changes with any slice
+
+    void print(){
+        std::cout << "Results:\n";
+        std::cout << "      nodes: " << nodes << "\n";
+        std::cout << "      edges: " << edges << "\n";
+        std::cout << "      slices: " << slices << "\n";
+        std::cout << "      avg_size unweighted: " << avg_size_uw << "\n";
+        std::cout << "      avg_size weighted: " << avg_size_w << "\n";
+
+    }
+};
+
+// a module that is a renamed copy of an earlier module, its representative. Swapping the vertices of both modules
+// (the k-th vertex of one with the k-th of the other) is verified to map every edge to an edge, so the slice of a
+// copy vertex is the slice of its representative vertex with both modules swapped
+struct ModuleCopy {
+    std::vector<int> representative_vertices;
+    std::vector<int> copy_vertices;
+};
+
+// modules with the same canonical text as an earlier module, if swapping them is an automorphism of the graph. Only
+// the variables and actions of the modules are renamed and only the two modules are swapped, so copies indexed by
+// constants, formulas or globals of their own, or reading each other's variables, are not found
+std::vector<ModuleCopy> find_module_copies(Vertices const& vertices, std::vector<std::vector<int>> const& adj_list,
+                                           storm::prism::Program const& program);
+
+// the slice with the vertices of the copy and its representative swapped
+std::vector<bool> map_through_copy(std::vector<bool> const& visited, ModuleCopy const& copy);
+
+// FNV-1a over the members of a slice
+uint64_t hash_slice(std::vector<bool> const& visited);
+
+Result benchmark(Vertices const& vertices,
+                 std::vector<std::vector<int>> const& adj_list,
+                  storm::prism::Program const& program,
+                  bool verbose = true,
+                  bool symmetry = false);
+
+// the same on the search graph of a slicer, with its numbering, hybrid rows and selected dependences
+Result benchmark(Slicer const& slicer, bool verbose = true, bool symmetry = false);
+
+// one model of a corpus run, also one line of the baseline file. In a baseline, values written as '-' are not
+// recorded yet: -1 for the counts and times, has_slices_hash false for the hash. run_corpus fails on them
+struct CorpusEntry {
+    std::string model;
+    int nodes = -1;
+    int edges = -1;
+    int slices = -1;
+    uint64_t slices_hash = 0;
+    bool has_slices_hash = false;
+    double build_seconds = -1;
+    double slicing_seconds = -1;
+};
+
+// the PRISM models (.prism, .pm, .nm, .sm) in dir, sorted by path
+std::vector<std::filesystem::path> model_files(std::string const& dir);
+
+CorpusEntry run_corpus_model(std::filesystem::path const& path, bool smt);
+
+std::map<std::string, CorpusEntry> read_corpus_baseline(std::string const& path);
+
+void write_corpus_baseline(std::string const& path, std::vector<CorpusEntry> const& entries);
+
+// benchmarks every model in dir and compares it with the baseline. Returns the number of failures: models that
+// fail to parse or to build, models with values not recorded in the baseline ('-'), changed counts or slices,
+// models missing from dir, and build or slicing times above (1 + threshold) * baseline. Differences below 10ms are
+// noise. With write_baseline the baseline is written instead (parse failures still count), without it a missing
+// baseline file throws std::invalid_argument
+int run_corpus(std::string const& dir, std::string const& baseline_path, double threshold, bool write_baseline, bool smt);
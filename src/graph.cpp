@@ -0,0 +1,1023 @@
+#include "graph.h"
+#include "trace.h"
+
+#include <storm/utility/cli.h>
+#include <storm/utility/solver.h>
+
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+// gatherVariables only fills a std::set, so the variables are collected in a reused scratch set
+// and then copied into the arena backed set of the node
+void gather_into(storm::expressions::Expression const& expr,
+                 std::set<Variable> &scratch,
+                 std::pmr::set<Variable> &target){
+    scratch.clear();
+    expr.gatherVariables(scratch);
+    target.insert(scratch.begin(), scratch.end());
+}
+
+bool is_zero_rate(storm::expressions::Expression const& rate){
+    return rate.isLiteral() && rate.evaluateAsDouble() == 0;
+}
+
+std::unordered_set<uint_fast64_t> alphabet_commands(storm::prism::Program const& program,
+                                                    std::unordered_set<uint_fast64_t> const& dead_commands){
+    std::unordered_set<uint_fast64_t> keep;
+    for(storm::prism::Module const& module : program.getModules()){
+        std::set<std::string> live_actions;
+        for(storm::prism::Command const& c : module.getCommands()){
+            if(c.isLabeled() && !dead_commands.count(c.getGlobalIndex())){ live_actions.insert(c.getActionName());}
+        }
+        for(storm::prism::Command const& c : module.getCommands()){
+            if(c.isLabeled() && live_actions.insert(c.getActionName()).second){ keep.insert(c.getGlobalIndex());}
+        }
+    }
+    return keep;
+}
+
+storm::prism::Program instantiate_constants(storm::prism::Program const& program, std::string const& definitions){
+    std::map<Variable, storm::expressions::Expression> constant_definitions =
+        storm::utility::cli::parseConstantDefinitionString(program.getManager(), definitions);
+    storm::prism::Program defined = program.defineUndefinedConstants(constant_definitions).substituteConstants();
+
+    std::unordered_set<uint_fast64_t> dead_commands;
+    for(storm::prism::Module const& module : defined.getModules()){
+        for(storm::prism::Command const& c : module.getCommands()){
+            bool live = !c.getGuardExpression().simplify().isFalse()
+                && std::any_of(c.getUpdates().begin(), c.getUpdates().end(), [](storm::prism::Update const& u){
+                       return !is_zero_rate(u.getLikelihoodExpression().simplify());
+                   });
+            if(!live){ dead_commands.insert(c.getGlobalIndex());}
+        }
+    }
+    std::unordered_set<uint_fast64_t> keep = alphabet_commands(defined, dead_commands);
+
+    std::vector<storm::prism::Module> modules;
+    for(storm::prism::Module const& module : defined.getModules()){
+        std::vector<storm::prism::Command> commands;
+        for(storm::prism::Command const& c : module.getCommands()){
+            if(dead_commands.count(c.getGlobalIndex())){
+                if(keep.count(c.getGlobalIndex())){
+                    // '[a] false -> true;' so the module still blocks a
+                    std::vector<storm::prism::Update> updates;
+                    updates.emplace_back(c.getUpdates().front().getGlobalIndex(), defined.getManager().rational(1),
+                                         std::vector<storm::prism::Assignment>(), c.getFilename(), c.getLineNumber());
+                    commands.emplace_back(c.getGlobalIndex(), c.isMarkovian(), c.getActionIndex(), c.getActionName(),
+                                          defined.getManager().boolean(false), updates, c.getFilename(), c.getLineNumber());
+                }
+                continue;
+            }
+
+            std::vector<storm::prism::Update> updates;
+            for(storm::prism::Update const& u : c.getUpdates()){
+                storm::expressions::Expression rate = u.getLikelihoodExpression().simplify();
+                if(is_zero_rate(rate)){ continue;}
+
+                std::vector<storm::prism::Assignment> assignments;
+                for(storm::prism::Assignment const& assg : u.getAssignments()){
+                    assignments.emplace_back(assg.getVariable(), assg.getExpression().simplify(), assg.getFilename(), assg.getLineNumber());
+                }
+                updates.emplace_back(u.getGlobalIndex(), rate, assignments, u.getFilename(), u.getLineNumber());
+            }
+
+            commands.emplace_back(c.getGlobalIndex(), c.isMarkovian(), c.getActionIndex(), c.getActionName(),
+                                  c.getGuardExpression().simplify(), updates, c.getFilename(), c.getLineNumber());
+        }
+        modules.emplace_back(module.getName(), module.getBooleanVariables(), module.getIntegerVariables(), module.getClockVariables(),
+                             module.getInvariant(), commands, module.getFilename(), module.getLineNumber());
+    }
+    return defined.replaceModulesAndConstantsInProgram(modules, defined.getConstants());
+}
+
+size_t count_components(storm::prism::Program const& program){
+    size_t count = program.getGlobalBooleanVariables().size() + program.getGlobalIntegerVariables().size();
+    count += program.getConstants().size() + program.getFormulas().size();
+    for(auto const& module : program.getModules()){
+        count += module.getBooleanVariables().size() + module.getIntegerVariables().size();
+        for(auto const& c : module.getCommands()){
+            count += 1; //guard
+            for(auto const& u : c.getUpdates()){
+                count += 1 + std::max<size_t>(1, u.getAssignments().size()); //rate and assignments (empty -> 'true')
+            }
+        }
+    }
+    count += program.getLabels().size();
+    for(auto const& reward_model : program.getRewardModels()){
+        count += reward_model.getStateRewards().size() + reward_model.getStateActionRewards().size()
+               + reward_model.getTransitionRewards().size();
+    }
+    if(program.hasInitialConstruct()){
+        count += 1;
+    }
+    return count;
+}
+
+void render_code_segment(BetterNode const& node, std::pmr::string &code){
+    code.clear();
+    if(node.type == "decl gb" || node.type == "decl gi" || node.type == "decl"){
+        if(node.type != "decl"){
+            code += "global ";
+        }
+        code += node.var.getName();
+        code += " : ";
+        if(node.lower.isInitialized()){
+            code += "[";
+            code += node.lower.toString();
+            code += "..";
+            code += node.upper.toString();
+            code += "]";
+        } else if(node.var.hasBooleanType()){
+            code += "bool";
+        } else {
+            code += "int";
+        }
+        if(node.expr.isInitialized()){
+            code += " init ";
+            code += node.expr.toString();
+        }
+    } else if(node.type == "decl c"){
+        code += "const ";
+        if(node.var.getType().isRationalType()){
+            code += "double"; // storm doesnt know double, it just knows 'rational' which is illegal type in prism
+        } else {
+            code += node.var.getType().getStringRepresentation();
+        }
+        code += " ";
+        code += node.var.getName();
+        if(node.expr.isInitialized()){
+            code += " = ";
+            code += node.expr.toString();
+        }
+    } else if(node.type == "decl f"){
+        code += "formula ";
+        code += node.var.getName();
+        code += " = ";
+        code += node.expr.toString();
+    } else if(node.type == "assignment"){
+        if(!node.expr.isInitialized()){ // empty assignment -> assignment = 'true'
+            code += "true";
+        } else {
+            code += "(";
+            code += node.var.getExpression().toString();
+            code += "'=";
+            code += node.expr.toString();
+            code += ")";
+        }
+    } else if(node.type == "label"){
+        code += "label \"";
+        code += node.name;
+        code += "\" = ";
+        code += node.expr.toString();
+    } else if(node.type == "reward s" || node.type == "reward a" || node.type == "reward t"){
+        if(node.type != "reward s"){
+            code += "[";
+            code += node.action;
+            code += "] ";
+        }
+        code += node.expr.toString();
+        if(node.type == "reward t"){
+            code += " -> ";
+            code += node.target.toString();
+        }
+        code += " : ";
+        code += node.value.toString();
+    } else if(node.type == "init"){
+        code += "init ";
+        code += node.expr.toString();
+        code += " endinit";
+    } else { // guard, rate
+        code += node.expr.toString();
+    }
+}
+
+Vertices build_vertices_for_program(storm::prism::Program const& program,
+                                    std::pmr::memory_resource *arena){
+    Vertices verts(arena);
+    verts.reserve(count_components(program));
+    std::set<Variable> scratch;
+
+    for(auto const& boolvar : program.getGlobalBooleanVariables()){
+        // Decl Node creation
+        BetterNode &ins_node = verts.emplace_back();
+        ins_node.identifier=boolvar.getExpressionVariable().getIndex(); //global identifier negative 1
+        ins_node.type="decl gb"; //decl global boolean
+        ins_node.module_name="global";
+        gather_into(boolvar.getExpression(), scratch, ins_node.ref);
+        ins_node.ref.insert(boolvar.getExpressionVariable());
+        ins_node.def.insert(boolvar.getExpressionVariable());
+
+        ins_node.var = boolvar.getExpressionVariable();
+        if(boolvar.hasInitialValue()){
+            ins_node.expr = boolvar.getInitialValueExpression();
+            gather_into(boolvar.getInitialValueExpression(), scratch, ins_node.ref);
+        }
+    }
+
+    for(auto const& intvar : program.getGlobalIntegerVariables()){
+        // Decl Node creation
+        BetterNode &ins_node = verts.emplace_back();
+        ins_node.identifier=intvar.getExpressionVariable().getIndex(); //global identifier negative 1
+        ins_node.type="decl gi"; //decl global int
+        ins_node.module_name="global";
+        gather_into(intvar.getExpression(), scratch, ins_node.ref);
+        ins_node.ref.insert(intvar.getExpressionVariable());
+        ins_node.def.insert(intvar.getExpressionVariable());
+
+        ins_node.var = intvar.getExpressionVariable();
+        if(!intvar.getRangeExpression().isTrue()){
+            ins_node.lower = intvar.getLowerBoundExpression();
+            ins_node.upper = intvar.getUpperBoundExpression();
+        }
+        if(intvar.hasInitialValue()){
+            ins_node.expr = intvar.getInitialValueExpression();
+            gather_into(intvar.getInitialValueExpression(), scratch, ins_node.ref);
+
+        }
+    }
+
+    for(auto const& constant :program.getConstants()){
+        // Decl Node creation
+        BetterNode &ins_node = verts.emplace_back();
+        ins_node.identifier=constant.getExpressionVariable().getIndex(); //global identifier negative 1
+        ins_node.type="decl c"; //decl global constant
+        ins_node.module_name="global";
+        ins_node.ref.insert(constant.getExpressionVariable());
+        ins_node.def.insert(constant.getExpressionVariable());
+
+        ins_node.var = constant.getExpressionVariable();
+        if(constant.isDefined()){ // undefined constants are given at check time
+            ins_node.expr = constant.getExpression();
+            gather_into(constant.getExpression(), scratch, ins_node.ref);
+        }
+    }
+
+    for(auto const& form : program.getFormulas()){
+        // Decl Node creation
+        BetterNode &ins_node = verts.emplace_back();
+        ins_node.identifier=form.getExpressionVariable().getIndex(); //global identifier negative 1
+        ins_node.type="decl f"; //decl global formula
+        ins_node.module_name="global";
+        gather_into(form.getExpression(), scratch, ins_node.ref);
+        ins_node.ref.insert(form.getExpressionVariable());
+        ins_node.def.insert(form.getExpressionVariable());
+
+        ins_node.var = form.getExpressionVariable();
+        ins_node.expr = form.getExpression();
+    }
+
+
+    for(auto const& module : program.getModules()){
+        PRISL_TRACE_SCOPE("build", "vertex build", module.getName());
+        for(storm::prism::BooleanVariable const& boolvar : module.getBooleanVariables()){
+            // Decl Node creation
+            BetterNode &ins_node = verts.emplace_back();
+            ins_node.identifier=boolvar.getExpressionVariable().getIndex(); //global identifier negative 1
+            ins_node.type="decl"; //decl global boolean
+            ins_node.module_name=module.getName();
+            gather_into(boolvar.getExpression(), scratch, ins_node.ref);
+            ins_node.ref.insert(boolvar.getExpressionVariable());
+            ins_node.def.insert(boolvar.getExpressionVariable());
+
+            ins_node.var = boolvar.getExpressionVariable();
+            if(boolvar.hasInitialValue()){
+                ins_node.expr = boolvar.getInitialValueExpression();
+                gather_into(boolvar.getInitialValueExpression(), scratch, ins_node.ref);
+            }
+            }
+
+        for(storm::prism::IntegerVariable const& intvar : module.getIntegerVariables()){
+
+            storm::expressions::Expression rangeexpr = intvar.getRangeExpression();
+
+            // Decl Node creation
+            BetterNode &ins_node = verts.emplace_back();
+            ins_node.identifier=intvar.getExpressionVariable().getIndex(); //global identifier negative 1
+            ins_node.type="decl"; //decl global boolean
+            ins_node.module_name=module.getName();
+            gather_into(intvar.getExpression(), scratch, ins_node.ref);
+            if(!rangeexpr.isTrue()){
+                gather_into(intvar.getLowerBoundExpression(), scratch, ins_node.ref);
+                gather_into(intvar.getUpperBoundExpression(), scratch, ins_node.ref);
+                ins_node.lower = intvar.getLowerBoundExpression();
+                ins_node.upper = intvar.getUpperBoundExpression();
+            }
+
+            ins_node.ref.insert(intvar.getExpressionVariable());
+            ins_node.def.insert(intvar.getExpressionVariable());
+
+            ins_node.var = intvar.getExpressionVariable();
+            if(intvar.hasInitialValue()){
+                ins_node.expr = intvar.getInitialValueExpression();
+                gather_into(intvar.getInitialValueExpression(), scratch, ins_node.ref);
+
+            }
+        }
+
+        for(storm::prism::Command const& c : module.getCommands()){
+
+            // create Guard Node 
+            BetterNode &guard_node = verts.emplace_back();
+            guard_node.identifier=c.getGlobalIndex(); //global identifier negative 1
+            guard_node.type="guard"; //decl global boolean
+            guard_node.module_name=module.getName();
+            gather_into(c.getGuardExpression(), scratch, guard_node.ref);
+            // def = emptyset
+            guard_node.expr=c.getGuardExpression();
+
+            for(storm::prism::Update const& u : c.getUpdates()){
+                // create rate Node 
+                BetterNode &rate_node = verts.emplace_back();
+                rate_node.identifier=u.getGlobalIndex(); 
+                rate_node.type="rate"; //decl global boolean
+                rate_node.module_name=module.getName();
+                gather_into(u.getLikelihoodExpression(), scratch, rate_node.ref);
+                // def = emptyset
+                rate_node.expr=u.getLikelihoodExpression();
+
+                if(u.getAssignments().size() == 0){ // empty assignment -> assignment = 'true'
+                    // create rate Node 
+                    BetterNode &ins_node = verts.emplace_back();
+                    ins_node.identifier=u.getGlobalIndex(); //global identifier negative 1
+                    ins_node.type="assignment"; //decl global boolean
+                    ins_node.module_name=module.getName();
+                    // ref = emptyset
+                    // def = emptyset
+                    // expr = uninitialized -> rendered as 'true'
+
+                } else {
+
+                    for(storm::prism::Assignment const& ass : u.getAssignments()){
+                        // create rate Node 
+                        BetterNode &ins_node = verts.emplace_back();
+                        ins_node.identifier=u.getGlobalIndex(); //global identifier negative 1
+                        ins_node.type="assignment"; //decl global boolean
+                        ins_node.module_name=module.getName();
+                        gather_into(ass.getExpression(), scratch, ins_node.ref);
+                        ins_node.def.insert(ass.getVariable());
+
+                        ins_node.var = ass.getVariable();
+                        ins_node.expr = ass.getExpression();
+                    }
+                }
+                
+                
+
+            }
+
+        }
+        
+
+
+    }
+    // labels and reward items belong to no module, nothing depends on them
+    for(int l = 0; l < program.getLabels().size(); l++){
+        storm::prism::Label const& label = program.getLabels().at(l);
+        BetterNode &ins_node = verts.emplace_back();
+        ins_node.identifier = l; //index of the label
+        ins_node.type = "label";
+        gather_into(label.getStatePredicateExpression(), scratch, ins_node.ref);
+        // def = emptyset
+        ins_node.name = label.getName();
+        ins_node.expr = label.getStatePredicateExpression();
+    }
+
+    for(int r = 0; r < program.getRewardModels().size(); r++){
+        storm::prism::RewardModel const& reward_model = program.getRewardModels().at(r);
+        for(auto const& reward : reward_model.getStateRewards()){
+            BetterNode &ins_node = verts.emplace_back();
+            ins_node.identifier = r; //index of the reward model
+            ins_node.type = "reward s"; //state reward
+            gather_into(reward.getStatePredicateExpression(), scratch, ins_node.ref);
+            gather_into(reward.getRewardValueExpression(), scratch, ins_node.ref);
+            // def = emptyset
+            ins_node.name = reward_model.getName();
+            ins_node.expr = reward.getStatePredicateExpression();
+            ins_node.value = reward.getRewardValueExpression();
+        }
+        for(auto const& reward : reward_model.getStateActionRewards()){
+            BetterNode &ins_node = verts.emplace_back();
+            ins_node.identifier = r; //index of the reward model
+            ins_node.type = "reward a"; //state-action reward, earned by the commands with the action
+            gather_into(reward.getStatePredicateExpression(), scratch, ins_node.ref);
+            gather_into(reward.getRewardValueExpression(), scratch, ins_node.ref);
+            // def = emptyset
+            ins_node.name = reward_model.getName();
+            if(reward.isLabeled()){
+                ins_node.action = reward.getActionName();
+            }
+            ins_node.expr = reward.getStatePredicateExpression();
+            ins_node.value = reward.getRewardValueExpression();
+        }
+        for(auto const& reward : reward_model.getTransitionRewards()){
+            BetterNode &ins_node = verts.emplace_back();
+            ins_node.identifier = r; //index of the reward model
+            ins_node.type = "reward t"; //transition reward, earned by the commands with the action
+            gather_into(reward.getSourceStatePredicateExpression(), scratch, ins_node.ref);
+            gather_into(reward.getTargetStatePredicateExpression(), scratch, ins_node.ref);
+            gather_into(reward.getRewardValueExpression(), scratch, ins_node.ref);
+            // def = emptyset
+            ins_node.name = reward_model.getName();
+            if(reward.isLabeled()){
+                ins_node.action = reward.getActionName();
+            }
+            ins_node.expr = reward.getSourceStatePredicateExpression();
+            ins_node.target = reward.getTargetStatePredicateExpression();
+            ins_node.value = reward.getRewardValueExpression();
+        }
+    }
+
+    if(program.hasInitialConstruct()){
+            BetterNode &ins_node = verts.emplace_back();
+            ins_node.identifier = -1;
+            ins_node.type = "init";
+            ins_node.module_name = "global";
+            gather_into(program.getInitialStatesExpression(), scratch, ins_node.ref);
+            ins_node.expr = program.getInitialStatesExpression();
+
+        }
+
+    //print and test 
+    // for(BetterNode const& node : verts){
+    //     std::cout << node.code_segment() << ": ";
+    //     std::cout << "{type:" << node.type << ", ID:" << node.identifier << ", Mod: " << node.module_name << ", ref:{";
+    //     for(auto var : node.ref){
+    //         std::cout << var.getName() << ", ";
+    //     }
+    //     std::cout << "}, def:{";
+    //     for(auto var : node.def){
+    //         std::cout << var.getName() << ", ";
+    //     }
+    //     std::cout << "}}" << std::endl;
+    // }
+    // std::cout<< "Amount of vertices = " << verts.size() << std::endl;
+
+    return verts;
+}
+
+std::string get_action_of_guard_node(storm::prism::Program const& program, BetterNode const& guard){
+    std::string action;
+    std::unordered_map< uint_fast64_t, std::string> cid_to_action = program.buildCommandIndexToActionNameMap();
+    action = cid_to_action[guard.identifier];
+    return action;
+}
+
+Vertices get_all_guard_nodes(Vertices const& inputnodes){
+    Vertices guards;
+    for(BetterNode const& node : inputnodes){
+        if(node.type == "guard"){
+            guards.push_back(node);
+        }
+    }
+    return guards;
+}
+
+std::unordered_map<uint_fast64_t, uint_fast64_t> build_assgID_to_comID_map(Vertices const& vertices, storm::prism::Program const& program){
+    
+    std::unordered_map<uint_fast64_t, uint_fast64_t> assgID_to_comID_map;
+
+    Vertices guards = get_all_guard_nodes(vertices);
+
+    for(BetterNode const& guard : guards){
+        storm::prism::Module mod = program.getModule(std::string(guard.module_name));                                                                                                            //but node ID is global command index 
+        storm::prism::Command com;
+        for(auto command : mod.getCommands()){
+            if(command.getGlobalIndex() == guard.identifier){ com = command;}
+        }
+
+        for(storm::prism::Update u : com.getUpdates()){
+            uint_fast64_t glob_index = u.getGlobalIndex();
+            for(int i = 0; i < vertices.size(); i++){
+                if((vertices.at(i).identifier == glob_index) && (vertices.at(i).type=="assignment")){
+                    assgID_to_comID_map[vertices.at(i).identifier] = guard.identifier;
+                }
+            }
+        }
+    }
+    return assgID_to_comID_map;
+}
+
+SyncRelation::SyncRelation(storm::prism::Program const& program){
+    std::map<std::pair<std::string, std::string>, int> keys;
+    std::map<std::string, std::map<std::string, int>> module_actions; // module -> action -> key
+    for(storm::prism::Module const& module : program.getModules()){
+        module_actions[module.getName()];
+        for(storm::prism::Command const& c : module.getCommands()){
+            if(!c.isLabeled()){ continue;}
+            int key = keys.emplace(std::make_pair(module.getName(), c.getActionName()), keys.size()).first->second;
+            command_key[c.getGlobalIndex()] = key;
+            module_actions[module.getName()][c.getActionName()] = key;
+        }
+    }
+
+    if(program.specifiesSystemComposition()){
+        compose(program.getSystemCompositionConstruct().getSystemComposition(), module_actions);
+        return;
+    }
+    // default composition: every two modules synchronize on their common actions
+    for(auto m1 = module_actions.begin(); m1 != module_actions.end(); ++m1){
+        for(auto m2 = std::next(m1); m2 != module_actions.end(); ++m2){
+            for(auto const& action : m1->second){
+                std::map<std::string, int>::const_iterator other = m2->second.find(action.first);
+                if(other != m2->second.end()){
+                    pairs.emplace(action.second, other->second);
+                    pairs.emplace(other->second, action.second);
+                }
+            }
+        }
+    }
+}
+
+SyncRelation::VisibleActions SyncRelation::compose(storm::prism::Composition const& composition,
+                                                   std::map<std::string, std::map<std::string, int>> const& module_actions){
+    if(auto module = dynamic_cast<storm::prism::ModuleComposition const*>(&composition)){
+        VisibleActions visible;
+        std::map<std::string, std::map<std::string, int>>::const_iterator it = module_actions.find(module->getModuleName());
+        if(it != module_actions.end()){
+            for(auto const& action : it->second){
+                visible.emplace_back(action.second, action.first);
+            }
+        }
+        return visible;
+    }
+    if(auto renaming = dynamic_cast<storm::prism::RenamingComposition const*>(&composition)){
+        VisibleActions visible = compose(renaming->getSubcomposition(), module_actions);
+        for(auto &action : visible){
+            std::map<std::string, std::string>::const_iterator renamed = renaming->getActionRenaming().find(action.second);
+            if(renamed != renaming->getActionRenaming().end()){
+                action.second = renamed->second;
+            }
+        }
+        return visible;
+    }
+    if(auto hiding = dynamic_cast<storm::prism::HidingComposition const*>(&composition)){
+        VisibleActions visible = compose(hiding->getSubcomposition(), module_actions);
+        // hidden actions are silent above, they synchronize with nothing
+        visible.erase(std::remove_if(visible.begin(), visible.end(), [hiding](std::pair<int, std::string> const& action){
+            return hiding->getActionsToHide().count(action.second) > 0;
+        }), visible.end());
+        return visible;
+    }
+    if(auto parallel = dynamic_cast<storm::prism::BinaryParallelComposition const*>(&composition)){
+        VisibleActions left = compose(parallel->getLeftSubcomposition(), module_actions);
+        VisibleActions right = compose(parallel->getRightSubcomposition(), module_actions);
+        bool interleaving = dynamic_cast<storm::prism::InterleavingParallelComposition const*>(parallel) != nullptr;
+        auto restricted = dynamic_cast<storm::prism::RestrictedParallelComposition const*>(parallel);
+        if(!interleaving){
+            for(auto const& l : left){
+                for(auto const& r : right){
+                    if(l.second == r.second && (restricted == nullptr || restricted->getSynchronizingActions().count(l.second))){
+                        pairs.emplace(l.first, r.first);
+                        pairs.emplace(r.first, l.first);
+                    }
+                }
+            }
+        }
+        left.insert(left.end(), right.begin(), right.end());
+        return left;
+    }
+    throw std::invalid_argument( "unsupported composition in the system block" );
+}
+
+bool SyncRelation::synchronize(uint_fast64_t command1, uint_fast64_t command2) const {
+    std::unordered_map<uint_fast64_t, int>::const_iterator key1 = command_key.find(command1);
+    std::unordered_map<uint_fast64_t, int>::const_iterator key2 = command_key.find(command2);
+    if(key1 == command_key.end() || key2 == command_key.end()){ return false;} // unlabeled
+    return pairs.count(std::make_pair(key1->second, key2->second)) > 0;
+}
+
+std::shared_ptr<storm::prism::Composition> restrict_composition(storm::prism::Composition const& composition,
+                                                                std::set<std::string> const& modules){
+    if(auto module = dynamic_cast<storm::prism::ModuleComposition const*>(&composition)){
+        if(!modules.count(module->getModuleName())){ return nullptr;}
+        return std::make_shared<storm::prism::ModuleComposition>(module->getModuleName());
+    }
+    if(auto renaming = dynamic_cast<storm::prism::RenamingComposition const*>(&composition)){
+        std::shared_ptr<storm::prism::Composition> sub = restrict_composition(renaming->getSubcomposition(), modules);
+        if(!sub){ return nullptr;}
+        return std::make_shared<storm::prism::RenamingComposition>(sub, renaming->getActionRenaming());
+    }
+    if(auto hiding = dynamic_cast<storm::prism::HidingComposition const*>(&composition)){
+        std::shared_ptr<storm::prism::Composition> sub = restrict_composition(hiding->getSubcomposition(), modules);
+        if(!sub){ return nullptr;}
+        return std::make_shared<storm::prism::HidingComposition>(sub, hiding->getActionsToHide());
+    }
+    if(auto parallel = dynamic_cast<storm::prism::BinaryParallelComposition const*>(&composition)){
+        std::shared_ptr<storm::prism::Composition> left = restrict_composition(parallel->getLeftSubcomposition(), modules);
+        std::shared_ptr<storm::prism::Composition> right = restrict_composition(parallel->getRightSubcomposition(), modules);
+        if(!left){ return right;}
+        if(!right){ return left;}
+        if(dynamic_cast<storm::prism::InterleavingParallelComposition const*>(parallel)){
+            return std::make_shared<storm::prism::InterleavingParallelComposition>(left, right);
+        }
+        if(auto restricted = dynamic_cast<storm::prism::RestrictedParallelComposition const*>(parallel)){
+            return std::make_shared<storm::prism::RestrictedParallelComposition>(left, restricted->getSynchronizingActions(), right);
+        }
+        return std::make_shared<storm::prism::SynchronizingParallelComposition>(left, right);
+    }
+    throw std::invalid_argument( "unsupported composition in the system block" );
+}
+
+bool depgg(BetterNode const& v1, BetterNode const& v2, SyncRelation const& sync){
+    if(v1.type=="guard" && v2.type=="guard"){
+        if(v1.module_name != v2.module_name){
+            return sync.synchronize(v1.identifier, v2.identifier);
+        }
+    }
+    return false;
+}
+
+bool depag(BetterNode const& v1, BetterNode const& v2, std::unordered_map<uint_fast64_t, uint_fast64_t> &aID_to_cID){
+    if(v1.type == "assignment" || v1.type == "rate"){
+        if(v2.type == "guard"){
+            if(aID_to_cID[v1.identifier] == v2.identifier){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool depar(BetterNode const& v1, BetterNode const& v2){
+    if(v1.identifier == v2.identifier){
+        if(v1.type == "assignment"){
+            if(v2.type == "rate"){
+                return true;
+            }
+        }
+    }
+    return false;
+    // return ((v1_assg && v2_rate) || (v1_rate && v2_assg)) && related;
+}
+
+// state-action and transition rewards depend on the guards of the commands they are earned by
+bool depra(BetterNode const& v1, BetterNode const& v2, std::unordered_map< uint_fast64_t, std::string> &cid_to_action){
+    if((v1.type == "reward a" || v1.type == "reward t") && v2.type == "guard"){
+        if(std::string_view(v1.action) == cid_to_action[v2.identifier]){
+            return true;
+        }
+    }
+    return false;
+}
+
+// declarations depend on the init construct that gives their variables the initial values
+bool depdi(BetterNode const& v1, BetterNode const& v2){
+    if(v1.type.find("decl") != std::string::npos){//type contains 'decl'?
+        if(v2.type == "init"){
+            for(storm::expressions::Variable decl_var : v1.def){
+                for(storm::expressions::Variable init_var : v2.ref){
+                    if(decl_var.getName() == init_var.getName()){
+                        return true;
+                    }
+                }
+            }
+        }
+    } 
+    return false;
+}
+
+SyncPruner::SyncPruner(storm::prism::Program const& program)
+    : solver(storm::utility::solver::getSmtSolver(program.getManager())) {
+    storm::prism::Program substituted = program.substituteConstantsFormulas();
+    for(storm::prism::IntegerVariable const& var : substituted.getGlobalIntegerVariables()){
+        ranges.emplace(var.getExpressionVariable(), var.getRangeExpression());
+    }
+    for(storm::prism::Module const& module : substituted.getModules()){
+        for(storm::prism::IntegerVariable const& var : module.getIntegerVariables()){
+            ranges.emplace(var.getExpressionVariable(), var.getRangeExpression());
+        }
+        for(storm::prism::Command const& c : module.getCommands()){
+            guards.emplace(c.getGlobalIndex(), c.getGuardExpression());
+        }
+    }
+}
+
+// replaces the identifiers of code that are in names by $v0, $v1, ... in order of appearance, continuing renaming
+std::string rename_variables(std::string const& code, std::map<std::string, Variable> const& names,
+                             std::vector<std::string> &renamed){
+    std::string text;
+    size_t k = 0;
+    while(k < code.size()){
+        if(std::isalpha(static_cast<unsigned char>(code[k])) || code[k] == '_'){
+            size_t begin = k;
+            while(k < code.size() && (std::isalnum(static_cast<unsigned char>(code[k])) || code[k] == '_')){ k++;}
+            std::string identifier = code.substr(begin, k - begin);
+            if(!names.count(identifier)){
+                text += identifier;
+                continue;
+            }
+            std::vector<std::string>::iterator it = std::find(renamed.begin(), renamed.end(), identifier);
+            text += "$v" + std::to_string(it - renamed.begin());
+            if(it == renamed.end()){ renamed.push_back(identifier);}
+        } else {
+            text += code[k++];
+        }
+    }
+    return text;
+}
+
+std::string SyncPruner::pair_key(storm::expressions::Expression const& guard1, storm::expressions::Expression const& guard2,
+                                 std::map<std::string, Variable> const& names) const {
+    std::vector<std::string> renamed;
+    std::string key = rename_variables(guard1.toString(), names, renamed) + "|" + rename_variables(guard2.toString(), names, renamed);
+    // the solver also sees the ranges, the key has to tell the variables with different ranges apart
+    for(size_t v = 0; v < renamed.size(); v++){
+        Variable const& var = names.at(renamed[v]);
+        std::map<Variable, storm::expressions::Expression>::const_iterator range = ranges.find(var);
+        key += "|";
+        if(range != ranges.end()){
+            key += rename_variables(range->second.toString(), names, renamed);
+        } else {
+            key += var.getType().getStringRepresentation();
+        }
+    }
+    return key;
+}
+
+bool SyncPruner::compatible(uint_fast64_t command1, uint_fast64_t command2){
+    storm::expressions::Expression const& guard1 = guards.at(command1);
+    storm::expressions::Expression const& guard2 = guards.at(command2);
+    // '[a] false' commands only keep their action blocked (see instantiate_constants), that is what their edges are for
+    if(guard1.isFalse() || guard2.isFalse()){ return true;}
+
+    std::set<Variable> variables;
+    guard1.gatherVariables(variables);
+    guard2.gatherVariables(variables);
+    // the pair up to renaming its variables: the guards of replicated modules only differ by the names of their
+    // variables (loc_1, loc_2) and share one solver call, in both orders
+    std::map<std::string, Variable> names;
+    for(Variable const& var : variables){
+        names.emplace(var.getName(), var);
+    }
+    std::string key = std::min(pair_key(guard1, guard2, names), pair_key(guard2, guard1, names));
+    std::map<std::string, bool>::iterator it = cache.find(key);
+    if(it != cache.end()){ return it->second;}
+
+    solver->push();
+    solver->add(guard1 && guard2);
+    for(Variable const& var : variables){
+        std::map<Variable, storm::expressions::Expression>::iterator range = ranges.find(var);
+        if(range != ranges.end()){ solver->add(range->second);}
+    }
+    bool result = solver->check() != storm::solver::SmtSolver::CheckResult::Unsat;
+    solver->pop();
+    checks += 1;
+    if(!result){ pruned_pairs += 1;}
+    cache.emplace(key, result);
+    return result;
+}
+
+// the depgg partners of guard i the pruner drops: guards of a partner module that can never hold together with i, as
+// long as another guard of that module still can. If none can, the first of them stays, so the partner keeps the
+// action in its alphabet and still blocks i in the slice (as alphabet_commands does for dead commands)
+std::unordered_set<int> pruned_sync_partners(Vertices const& vertices, int i, SyncRelation const& sync, SyncPruner &pruner){
+    std::map<std::string, std::vector<int>> incompatible; // partner module -> its guards that never hold with i
+    std::set<std::string> compatible_modules;
+    for(int j = 0; j < vertices.size(); j++){
+        if(i == j || !depgg(vertices.at(i), vertices.at(j), sync)){ continue;}
+        std::string module(vertices.at(j).module_name);
+        if(pruner.compatible(vertices.at(i).identifier, vertices.at(j).identifier)){
+            compatible_modules.insert(module);
+        } else {
+            incompatible[module].push_back(j);
+        }
+    }
+    std::unordered_set<int> pruned;
+    for(std::pair<const std::string, std::vector<int>> const& partner : incompatible){
+        std::vector<int>::const_iterator first = partner.second.begin();
+        if(!compatible_modules.count(partner.first)){ ++first;}
+        pruned.insert(first, partner.second.end());
+    }
+    return pruned;
+}
+
+std::vector<std::vector<int>> build_comp_adj_list(Vertices const& vertices, storm::prism::Program const& program, SyncPruner* pruner,
+                                                  EdgeKindList* edge_kinds, EdgeKinds mask){
+    PRISL_TRACE_SCOPE("build", "edge build");
+    std::vector<std::vector<int>> comp_adj_list;
+    comp_adj_list.reserve(vertices.size());
+    if(edge_kinds != nullptr){
+        edge_kinds->clear();
+        edge_kinds->reserve(vertices.size());
+    }
+
+    std::unordered_map< uint_fast64_t, std::string> cid_to_action = program.buildCommandIndexToActionNameMap();
+    std::unordered_map<uint_fast64_t, uint_fast64_t> aID_to_cID = build_assgID_to_comID_map(vertices, program);
+    SyncRelation sync(program);
+    // without edge_kinds only the existence of an edge matters, the first kind found is enough
+    bool all_kinds = edge_kinds != nullptr;
+
+    for(int i = 0; i < vertices.size(); i++){
+        std::vector<int> adj_vector={};
+        std::vector<EdgeKinds> kinds_vector={};
+        std::unordered_set<int> pruned;
+        if(pruner != nullptr && (mask & DEP_GG) && vertices.at(i).type == "guard"){
+            pruned = pruned_sync_partners(vertices, i, sync, *pruner);
+        }
+        for(int j = 0; j < vertices.size(); j++){
+            if(i==j) {continue;}
+            EdgeKinds kinds = 0;
+            // cdep 
+            //      depar 
+            if( (mask & DEP_AR) && depar(vertices.at(i), vertices.at(j)) ){
+                kinds |= DEP_AR;
+            }
+            //      depgg
+            if( (mask & DEP_GG) && (all_kinds || kinds == 0) && depgg(vertices.at(i), vertices.at(j), sync) && !pruned.count(j) ){
+                kinds |= DEP_GG;
+            }
+            //      depag
+            if( (mask & DEP_AG) && (all_kinds || kinds == 0) && depag(vertices.at(i), vertices.at(j), aID_to_cID) ){
+                kinds |= DEP_AG;
+            }
+            //      depra
+            if( (mask & DEP_RA) && (all_kinds || kinds == 0) && depra(vertices.at(i), vertices.at(j), cid_to_action) ){
+                kinds |= DEP_RA;
+            }
+            //      depdi
+            if( (mask & DEP_DI) && (all_kinds || kinds == 0) && depdi(vertices.at(i), vertices.at(j)) ){
+                kinds |= DEP_DI;
+            }
+
+            // ddep
+            //ddep ref(vertices[i]) setintersection def(vertices[j]) != emptyset
+            if( (mask & DEP_DATA) && (all_kinds || kinds == 0) ){
+                bool transition = false;
+                for(Variable vari : vertices.at(i).ref){
+                    for(Variable varj : vertices.at(j).def){
+                        if(vari.getName() == varj.getName()){
+                            kinds |= DEP_DATA;
+                            transition = true;
+                            break;
+                        }
+                    }
+                    if(transition) {break;}
+                }
+            }
+
+            if(kinds != 0){
+                adj_vector.push_back(j);
+                kinds_vector.push_back(kinds);
+            }
+        }
+        comp_adj_list.push_back(adj_vector);
+        if(edge_kinds != nullptr){
+            edge_kinds->push_back(kinds_vector);
+        }
+    }
+    return comp_adj_list;
+
+}
+
+std::vector<std::vector<int>> masked_adj_list(std::vector<std::vector<int>> const& adj_list, EdgeKindList const& edge_kinds, EdgeKinds mask){
+    std::vector<std::vector<int>> masked(adj_list.size());
+    for(int i = 0; i < adj_list.size(); i++){
+        for(int k = 0; k < adj_list[i].size(); k++){
+            if(edge_kinds[i][k] & mask){
+                masked[i].push_back(adj_list[i][k]);
+            }
+        }
+    }
+    return masked;
+}
+
+EdgeKinds parse_dependence_kinds(std::string const& list){
+    static const std::map<std::string, EdgeKinds> names = {
+        {"ar", DEP_AR}, {"gg", DEP_GG}, {"ag", DEP_AG}, {"data", DEP_DATA}, {"di", DEP_DI}, {"ra", DEP_RA},
+        {"all", DEP_ALL}, {"default", DEP_DEFAULT}
+    };
+    // getline returns no item for a trailing comma
+    if(list.empty() || list.back() == ','){
+        throw std::invalid_argument( "expected a comma separated list of dependence kinds; but got: '" + list + "'" );
+    }
+    EdgeKinds mask = 0;
+    std::istringstream items(list);
+    std::string item;
+    bool first = true;
+    while(std::getline(items, item, ',')){
+        bool removed = !item.empty() && item.front() == '-';
+        if(removed){
+            item.erase(0, 1);
+            if(first){ mask = DEP_DEFAULT;}
+        }
+        std::map<std::string, EdgeKinds>::const_iterator it = names.find(item);
+        if(it == names.end()){
+            throw std::invalid_argument( "unknown dependence kind '" + item + "' in " + list
+                                         + ", expected ar|gg|ag|data|di|ra|all|default" );
+        }
+        mask = removed ? (mask & ~it->second) : (mask | it->second);
+        first = false;
+    }
+    if(mask == 0){
+        throw std::invalid_argument( "dependence kinds " + list + " select no kind, a slice would only contain its criteria" );
+    }
+    return mask;
+}
+
+std::vector<Module_node> get_module_nodes(Vertices const& vertices, storm::prism::Program const& program){
+    std::vector<Module_node> program_module_nodes={};
+    std::unordered_map<std::string, int> module_position;
+    Module_node ins;
+    for(storm::prism::Module const& m : program.getModules()) {
+        module_position[m.getName()] = program_module_nodes.size();
+        ins.module_name=m.getName();
+        program_module_nodes.push_back(ins);
+    }
+    module_position["global"] = program_module_nodes.size();
+    ins.module_name= "global";
+    program_module_nodes.push_back(ins);
+
+    std::unordered_map< uint_fast64_t, std::string> cid_to_action = program.buildCommandIndexToActionNameMap();
+    for(BetterNode const& node : vertices){
+        if(node.module_name.empty()){ continue;} // labels and reward items belong to no module
+        Module_node &mod = program_module_nodes.at(module_position.at(std::string(node.module_name)));
+        // !!REF!! and !!DEF!!
+        mod.ref.insert(node.ref.begin(), node.ref.end());
+        mod.def.insert(node.def.begin(), node.def.end());
+
+        // !!ACTIONS!!
+        if(node.type == "guard"){
+            std::string const& action = cid_to_action[node.identifier];
+            if(action.length() != 0) {mod.act.insert(action);}
+        }
+    }
+    return program_module_nodes;
+}
+
+std::vector<std::vector<int>> quotient_adj_list(Vertices const& vertices,
+                                                std::vector<std::vector<int>> const& comp_adj_list,
+                                                std::vector<Module_node> const& mod_nodes){
+    std::unordered_map<std::string, int> module_position;
+    for(int i = 0; i < mod_nodes.size(); i++){
+        module_position[mod_nodes.at(i).module_name] = i;
+    }
+    std::vector<int> module_of_vertex;
+    module_of_vertex.reserve(vertices.size());
+    for(BetterNode const& node : vertices){
+        module_of_vertex.push_back(node.module_name.empty() ? -1 : module_position.at(std::string(node.module_name)));
+    }
+
+    std::vector<std::vector<bool>> transition(mod_nodes.size(), std::vector<bool>(mod_nodes.size(), false));
+    for(int v = 0; v < vertices.size(); v++){
+        if(module_of_vertex[v] < 0){ continue;} // labels and reward items, nothing depends on them
+        for(int w : comp_adj_list.at(v)){
+            transition[module_of_vertex[v]][module_of_vertex[w]] = true;
+        }
+    }
+
+    std::vector<std::vector<int>> adj_list(mod_nodes.size());
+    for(int i = 0; i < mod_nodes.size(); i++){
+        for(int j = 0; j < mod_nodes.size(); j++){
+            if(i != j && transition[i][j]){
+                adj_list[i].push_back(j);
+            }
+        }
+    }
+    return adj_list;
+}
+
+VertexIndex build_code_index(Vertices const& vertices){
+    VertexIndex index;
+    index.reserve(vertices.size());
+    for(int i = 0; i < vertices.size(); i++){
+        index[std::string(vertices.at(i).code_segment())].push_back(i);
+    }
+    return index;
+}
+
+VertexIndex build_variable_index(Vertices const& vertices){
+    VertexIndex index;
+    for(int i = 0; i < vertices.size(); i++){
+        //if node.type contains string decl
+        if(vertices.at(i).type.find("decl") != std::string::npos){
+            for(storm::expressions::Variable const& var : vertices.at(i).def){
+                index[var.getName()].push_back(i);
+            }
+        }
+    }
+    return index;
+}
+
+VertexIndex build_module_index(Vertices const& vertices){
+    VertexIndex index;
+    for(int i = 0; i < vertices.size(); i++){
+        if(!vertices.at(i).module_name.empty()){
+            index[std::string(vertices.at(i).module_name)].push_back(i);
+        }
+    }
+    return index;
+}
+
+VertexIndex build_name_index(Vertices const& vertices, std::string const& type_prefix){
+    VertexIndex index;
+    for(int i = 0; i < vertices.size(); i++){
+        if(vertices.at(i).type.compare(0, type_prefix.size(), type_prefix) == 0){
+            index[std::string(vertices.at(i).name)].push_back(i);
+        }
+    }
+    return index;
+}
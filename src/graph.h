@@ -0,0 +1,232 @@
+#pragma once
+
+// component dependence graph: the components of a PRISM program (declarations, guards, rates, assignments, ...)
+// as vertices, an edge i -> j if component i depends on component j
+
+#include "mdg.h"
+
+#include <storm/storage/prism/Program.h>
+#include <storm/storage/expressions/BaseExpression.h>
+#include <storm/solver/SmtSolver.h>
+
+#include <map>
+#include <memory>
+#include <memory_resource> // arena for the vertex table
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+struct BetterNode;
+// renders the code segment of a vertex from the expressions it was built from
+void render_code_segment(BetterNode const& node, std::pmr::string &code);
+
+struct BetterNode {
+    // allocator aware, so a node emplaced into a Vertices table keeps its strings and sets in the arena of that table
+    typedef std::pmr::polymorphic_allocator<char> allocator_type;
+
+    uint_fast64_t identifier;
+    std::pmr::string type;
+    std::pmr::string module_name;
+    std::pmr::set<storm::expressions::Variable> def; //Names of the defined variables
+    std::pmr::set<storm::expressions::Variable> ref; //Names of the referenced/declared variables
+
+    // what the code segment is rendered from, see render_code_segment
+    storm::expressions::Variable var; //declared, defined or assigned variable
+    storm::expressions::Expression expr; //init value, definition, guard, rate, assigned expression or init block
+    storm::expressions::Expression lower; //bounds of declared integer variables with a range
+    storm::expressions::Expression upper;
+    storm::expressions::Expression value; //reward of a reward item, expr is its (source) state predicate
+    storm::expressions::Expression target; //target state predicate of a transition reward item
+    std::pmr::string name; //name of a label or of the reward model of a reward item
+    std::pmr::string action; //action of a state-action or transition reward item, empty for '[]'
+
+    // code segment, rendered on first use
+    std::pmr::string const& code_segment() const {
+        if(!code_rendered){
+            render_code_segment(*this, rendered_code);
+            code_rendered = true;
+        }
+        return rendered_code;
+    }
+
+    explicit BetterNode(allocator_type alloc = {})
+        : identifier(-1), type(alloc), module_name(alloc), def(alloc), ref(alloc), name(alloc), action(alloc), rendered_code(alloc) {}
+    BetterNode(BetterNode const& other, allocator_type alloc = {})
+        : identifier(other.identifier), type(other.type, alloc), module_name(other.module_name, alloc),
+          def(other.def, alloc), ref(other.ref, alloc), var(other.var), expr(other.expr), lower(other.lower), upper(other.upper),
+          value(other.value), target(other.target), name(other.name, alloc), action(other.action, alloc),
+          rendered_code(other.rendered_code, alloc), code_rendered(other.code_rendered) {}
+    BetterNode(BetterNode&& other, allocator_type alloc)
+        : identifier(other.identifier), type(std::move(other.type), alloc), module_name(std::move(other.module_name), alloc),
+          def(std::move(other.def), alloc), ref(std::move(other.ref), alloc),
+          var(std::move(other.var)), expr(std::move(other.expr)), lower(std::move(other.lower)), upper(std::move(other.upper)),
+          value(std::move(other.value)), target(std::move(other.target)), name(std::move(other.name), alloc), action(std::move(other.action), alloc),
+          rendered_code(std::move(other.rendered_code), alloc), code_rendered(other.code_rendered) {}
+    BetterNode(BetterNode&& other) = default;
+    BetterNode& operator=(BetterNode const& other) = default;
+    BetterNode& operator=(BetterNode&& other) = default;
+
+    // replaces the expression the code segment is rendered from
+    void replace_expr(storm::expressions::Expression new_expr){
+        expr = std::move(new_expr);
+        rendered_code.clear();
+        code_rendered = false;
+    }
+
+    void clear(){
+        identifier=-1;
+        type.clear();
+        module_name.clear();
+        def.clear();
+        ref.clear();
+        var = storm::expressions::Variable();
+        expr = storm::expressions::Expression();
+        lower = storm::expressions::Expression();
+        upper = storm::expressions::Expression();
+        value = storm::expressions::Expression();
+        target = storm::expressions::Expression();
+        name.clear();
+        action.clear();
+        rendered_code.clear();
+        code_rendered = false;
+    }
+
+private:
+    friend size_t vertex_string_bytes(BetterNode const& node);
+
+    mutable std::pmr::string rendered_code;
+    mutable bool code_rendered = false;
+};
+
+// vertex table of the component graph. Nodes are constructed in place, so everything they hold
+// comes from the memory resource of the table (see build_vertices_for_program)
+typedef std::pmr::vector<BetterNode> Vertices;
+
+// defines the constants given as 'N=3,K=2', substitutes all constants and simplifies guards, rates and
+// assignments. Updates whose rate became 0 are dropped, and so are commands whose guard became false or that have
+// no update left, unless they keep an action in the alphabet of their module (see alphabet_commands): those become
+// '[a] false -> true;'. Global indices stay those of the parsed program
+storm::prism::Program instantiate_constants(storm::prism::Program const& program, std::string const& definitions);
+
+// a module blocks the actions of its commands, dead or not. Of every module and action whose commands are all in
+// dead_commands this returns the first of them, it has to stay so the module still blocks the action
+std::unordered_set<uint_fast64_t> alphabet_commands(storm::prism::Program const& program,
+                                                    std::unordered_set<uint_fast64_t> const& dead_commands);
+
+// amount of vertices build_vertices_for_program will create, used to size the table once
+size_t count_components(storm::prism::Program const& program);
+
+// one vertex per component of the program, in program order; strings and sets are allocated from arena
+Vertices build_vertices_for_program(storm::prism::Program const& program,
+                                    std::pmr::memory_resource *arena = std::pmr::get_default_resource());
+
+// action name of the command of a guard vertex, "" if unlabeled
+std::string get_action_of_guard_node(storm::prism::Program const& program, BetterNode const& guard);
+
+// dependence kinds of an edge, all kinds that hold for the pair are set
+typedef uint8_t EdgeKinds;
+enum EdgeKind : EdgeKinds {
+    DEP_AR = 1,     // assignment -> rate of its update
+    DEP_GG = 2,     // guard -> guards synchronizing with it
+    DEP_AG = 4,     // assignment -> guard of its command
+    DEP_DATA = 8,   // ref -> def of a variable, constant or formula
+    DEP_DI = 16,    // declaration -> init construct
+    DEP_RA = 32     // state-action or transition reward -> guards of its action
+};
+const EdgeKinds DEP_ALL = DEP_AR | DEP_GG | DEP_AG | DEP_DATA | DEP_DI | DEP_RA;
+const EdgeKinds DEP_DEFAULT = DEP_ALL & ~DEP_DI; // what slices follow unless -deps is given
+
+// parallel to an adjacency list, edge_kinds[i][k] are the kinds of the edge i -> adj_list[i][k]
+typedef std::vector<std::vector<EdgeKinds>> EdgeKindList;
+
+// which commands of two modules synchronize (depgg). With a system...endsystem block this follows the composition:
+// two actions synchronize at the parallel composition that joins their modules if they have the same name there,
+// after the renamings and without the hidings below it, and the composition synchronizes on it (|| on the actions
+// both sides have, |[a,b]| on the listed ones, ||| on none). Without a system block all modules are composed with ||
+class SyncRelation {
+public:
+    explicit SyncRelation(storm::prism::Program const& program);
+
+    bool synchronize(uint_fast64_t command1, uint_fast64_t command2) const;
+
+private:
+    // actions of a subcomposition: key of the module and action they come from, and their name at this level
+    typedef std::vector<std::pair<int, std::string>> VisibleActions;
+    VisibleActions compose(storm::prism::Composition const& composition,
+                           std::map<std::string, std::map<std::string, int>> const& module_actions);
+
+    std::unordered_map<uint_fast64_t, int> command_key; // labeled command -> key of its module and action
+    std::set<std::pair<int, int>> pairs; // synchronizing keys, both orders
+};
+
+// the composition with only the given modules, parallel compositions with one empty side are replaced by the other
+// side. Null if none of the modules is in it. Used to write the system block of a slice
+std::shared_ptr<storm::prism::Composition> restrict_composition(storm::prism::Composition const& composition,
+                                                                std::set<std::string> const& modules);
+
+// optional pruning of depgg: two synchronizing guards that can never hold at the same time (with the ranges of
+// the integer variables) cannot block each other. A guard keeps one edge to a partner module all of whose guards on
+// the action are incompatible with it, since that module still blocks it (see build_comp_adj_list). Asks the SMT solver bundled with storm after substituting constants
+// and formulas. Results are cached per pair of guards up to renaming their variables (keeping the ranges apart), so
+// the pairs of replicated modules are only checked once
+class SyncPruner {
+public:
+    explicit SyncPruner(storm::prism::Program const& program);
+
+    // false only if the guards of both commands are unsatisfiable together, unknown keeps the edge
+    bool compatible(uint_fast64_t command1, uint_fast64_t command2);
+
+    size_t checks = 0; // solver calls, the rest was answered from the cache
+    size_t pruned_pairs = 0;
+
+private:
+    // both guards and the ranges of their variables, with the variables renamed in order of appearance
+    std::string pair_key(storm::expressions::Expression const& guard1, storm::expressions::Expression const& guard2,
+                         std::map<std::string, Variable> const& names) const;
+
+    std::unique_ptr<storm::solver::SmtSolver> solver;
+    std::map<Variable, storm::expressions::Expression> ranges;
+    std::unordered_map<uint_fast64_t, storm::expressions::Expression> guards;
+    std::map<std::string, bool> cache;
+};
+
+std::vector<std::vector<int>> build_comp_adj_list(Vertices const& vertices, storm::prism::Program const& program, SyncPruner* pruner = nullptr,
+                                                  EdgeKindList* edge_kinds = nullptr, EdgeKinds mask = DEP_DEFAULT);
+
+// the edges of a graph built with edge_kinds that have one of the kinds in mask, so a graph built once with
+// DEP_ALL can be sliced for any combination of kinds without evaluating the dependences again
+std::vector<std::vector<int>> masked_adj_list(std::vector<std::vector<int>> const& adj_list, EdgeKindList const& edge_kinds, EdgeKinds mask);
+
+// parses -deps, f.e. 'data', 'all' or 'default,-gg': a comma separated list of kinds (ar, gg, ag, data, di, ra)
+// and the sets 'all' and 'default' (all but di). A kind with a leading '-' is removed, starting from default.
+// Throws on an empty list or item, an unknown kind and on a list that removes every kind
+EdgeKinds parse_dependence_kinds(std::string const& list);
+
+// module nodes aggregated from the component vertices, so the variables of every expression are only
+// gathered once (by build_vertices_for_program). Modules are in program order, 'global' comes last
+std::vector<Module_node> get_module_nodes(Vertices const& vertices, storm::prism::Program const& program);
+
+// MDG ADJ List as the quotient of the component graph by module: module i depends on module j if a component
+// of i depends on a component of j. The synchronization edges are the depgg edges between guards of both modules.
+std::vector<std::vector<int>> quotient_adj_list(Vertices const& vertices,
+                                                std::vector<std::vector<int>> const& comp_adj_list,
+                                                std::vector<Module_node> const& mod_nodes);
+
+// criterion lookup table, maps a key to the indices of all vertices it names (in vertex order)
+typedef std::unordered_map<std::string, std::vector<int>> VertexIndex;
+
+// code segment -> vertices with this code segment, renders every code segment once
+VertexIndex build_code_index(Vertices const& vertices);
+
+// variable, constant or formula name -> declaring vertices
+VertexIndex build_variable_index(Vertices const& vertices);
+
+// module name (or 'global') -> vertices of this module
+VertexIndex build_module_index(Vertices const& vertices);
+
+// label name -> label vertex, reward model name -> its reward items; selected by the type prefix
+VertexIndex build_name_index(Vertices const& vertices, std::string const& type_prefix);
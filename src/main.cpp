@@ -1,3 +1,12 @@
+#include "benchmark.h"
+#include "graph.h"
+#include "mdg.h"
+#include "memory.h"
+#include "pipeline.h"
+#include "slicer.h"
+#include "stats.h"
+#include "trace.h"
+
 #include <storm/api/storm.h>
 #include <storm-parsers/api/storm-parsers.h>
 #include <storm-parsers/parser/PrismParser.h>
@@ -8,1430 +17,134 @@
 #include <storm/utility/initialize.h>
 
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <fstream> // for read/write on files
 #include <stdexcept>
 #include <string> //
-#include <sstream>// for std::ostringstream
 
 typedef storm::models::sparse::Dtmc<double> Dtmc;
-typedef storm::expressions::Variable Variable;
-
-
-
-struct Module_node {
-    std::string module_name;
-    std::set<storm::expressions::Variable> def; //Names of the defined variables
-    std::set<storm::expressions::Variable> ref; //Names of the referenced/declared variables
-    std::set<std::string> act; //Names of the used actions inside module
-
-    void reset_node(){
-        this->module_name.clear();
-        this->def.clear();
-        this->ref.clear();
-        this->act.clear();
-    }
-};
-
-std::set<storm::expressions::Variable> extract_globals_def(storm::prism::Program program){
-    std::set<storm::expressions::Variable> def={};
-    //globals 
-    for(auto boolvar : program.getGlobalBooleanVariables()){
-        //get var of declarated variable
-        def.insert(boolvar.getExpressionVariable());
-    }
-
-    for(auto intvar : program.getGlobalIntegerVariables()){
-        //get var of declarated variable
-        def.insert(intvar.getExpressionVariable());
-    }
-
-
-    //constants
-    for(auto constant : program.getConstants()){
-        def.insert(constant.getExpressionVariable());
-    }
-
-    //formulas 
-    for(auto formula : program.getFormulas()){
-        def.insert(formula.getExpressionVariable());
-    }
-
-    //init block 
-    if(program.hasInitialConstruct()){
-        program.getInitialConstruct().getInitialStatesExpression().gatherVariables(def);
-    }
-    return def;
-}
-
-std::set<storm::expressions::Variable> extract_globals_ref(storm::prism::Program program){
-    std::set<storm::expressions::Variable> ref={};
-    //globals 
-    for(auto boolvar : program.getGlobalBooleanVariables()){
-        //get var of declarated variable
-        ref.insert(boolvar.getExpressionVariable());
-
-        // get vars of used variables for declaration
-        boolvar.getInitialValueExpression().gatherVariables(ref);
-    }
-
-    for(auto intvar : program.getGlobalIntegerVariables()){
-        //get var of declarated variable
-        ref.insert(intvar.getExpressionVariable());
-
-        // get vars of used variables for range
-        intvar.getRangeExpression().gatherVariables(ref);
-
-        // get names of used variables for init value
-        intvar.getInitialValueExpression().gatherVariables(ref);
-    }
-
-
-    //constants
-    for(auto constant : program.getConstants()){
-        ref.insert(constant.getExpressionVariable());
-        constant.getExpression().gatherVariables(ref);
-    }
-
-    //formulas 
-    for(auto formula : program.getFormulas()){
-        ref.insert(formula.getExpressionVariable());
-        formula.getExpression().gatherVariables(ref);
-    }
-
-    
-    return ref;
-    
-}
-
-std::set<storm::expressions::Variable> extract_def(storm::prism::Module module){
-    std::set<storm::expressions::Variable> def={};
-    for(auto boolvar : module.getBooleanVariables()){
-        //get var of declarated variable
-        def.insert(boolvar.getExpressionVariable());
-    }
-
-    for(auto intvar : module.getIntegerVariables()){
-        //get var of declarated variable
-        def.insert(intvar.getExpressionVariable());
-    }
-
-    // now for Coms
-    for(auto com : module.getCommands()){
-        //now for updates
-        for(auto u : com.getUpdates()){
-            //now for assignments
-            for(auto a : u.getAssignments()){
-                def.insert(a.getVariable());
-            }
-        }
-    }
-    return def;
-}
-
-
-std::set<storm::expressions::Variable> extract_ref(storm::prism::Module module){
-    std::set<storm::expressions::Variable> ref={};
-    for(auto boolvar : module.getBooleanVariables()){
-        //get var of declarated variable
-        ref.insert(boolvar.getExpressionVariable());
-
-        // get vars of used variables for declaration
-        if(boolvar.hasInitialValue()){
-            boolvar.getInitialValueExpression().gatherVariables(ref);
-        }
-
-    }
-
-    for(auto intvar : module.getIntegerVariables()){
-        //get var of declarated variable
-        ref.insert(intvar.getExpressionVariable());
-
-        // get vars of used variables for range
-        intvar.getRangeExpression().gatherVariables(ref);
-
-        // get names of used variables for init value
-        if(intvar.hasInitialValue()){
-            intvar.getInitialValueExpression().gatherVariables(ref);
-        }
-
-    }
-
-    // now for Coms
-    for(auto com : module.getCommands()){
-        //first for guards
-        com.getGuardExpression().gatherVariables(ref);
-
-        //now for updates
-        for(auto u : com.getUpdates()){
-            //first for rate
-            u.getLikelihoodExpression().gatherVariables(ref);
-
-            //now for assignments
-            for(auto a : u.getAssignments()){
-                a.getExpression().gatherVariables(ref);
-            }
-        }
-    }
-    return ref;
-}
-
-
-std::set<std::string> extract_actions(storm::prism::Module module){
-    std::set<std::string> act={};
-    for(auto com : module.getCommands()){
-        std::string action=com.getActionName();
-        if(action.length() != 0) {act.insert(com.getActionName());}
-    }
-    return act;
-}
-
-std::vector<Module_node> get_module_nodes(storm::prism::Program p){
-    std::vector<Module_node> program_module_nodes={};
-    Module_node ins;
-    std::vector<storm::prism::Module> Mods = p.getModules();
-    for(storm::prism::Module m : Mods) {
-        ins.module_name=m.getName();
-        // !!REF!!
-        ins.ref=extract_ref(m);
-
-        // !!DEF!!
-        ins.def=extract_def(m);
-
-
-        // !!ACTIONS!!
-        ins.act=extract_actions(m);
-
-        program_module_nodes.push_back(ins);
-    }
-
-    //add vglob 
-    ins.module_name= "global";
-    ins.ref= extract_globals_ref(p);
-    ins.def= extract_globals_def(p);
-    ins.act.clear();
-    program_module_nodes.push_back(ins);
-    
-    return program_module_nodes;
-}
-
-// MDG ADJ List
-std::vector<std::vector<int>> create_adj_list(std::vector<Module_node> mod_nodes){
-    std::vector<std::vector<int>> adj_list;
-    adj_list.reserve(mod_nodes.size());
-    std::vector<int> adj_vector={};
-    adj_vector.reserve(mod_nodes.size());
-
-    for(int i = 0; i < mod_nodes.size(); i++){
-        adj_vector.clear();
-        for(int j = 0; j < mod_nodes.size(); j++){
-            if(i==j){
-                continue;
-                }
-
-            bool transition = false;
-
-
-            //cdep act(mod_nodes[i]) setintersection act(mod_nodes[j]) != emptyset
-                for(std::string acti : mod_nodes[i].act){
-                    for(std::string actj : mod_nodes[j].act){
-                        if(acti == actj){
-                            adj_vector.push_back(j);
-                            transition = true;
-                            break;
-                        }
-                    }
-                    if(transition) {break;}
-                }
-
-            //ddep ref(mod_nodes[i]) setintersection def(mod_nodes[j]) != emptyset
-            if(!transition){
-                for(Variable vari : mod_nodes[i].ref){
-                    for(Variable varj : mod_nodes[j].def){
-                        if(vari.getName() == varj.getName()){
-                            adj_vector.push_back(j);
-                            transition = true;
-                            break;
-                        }
-                    }
-                    if(transition) {break;}
-                }
-            }
-
-            
-
-            
-        }
-        adj_list.push_back(adj_vector);
-    }
-
-    return adj_list;
-}
-
-std::vector<Module_node> slice_mdg( std::vector<std::vector<int>> adj_list, 
-                                    std::vector<Module_node> module_nodes, 
-                                    std::vector<std::string> crits){
-//return subseteq of module_nodes containing only the module_nodes relevant for module with name crit
-    std::vector<Module_node> slice={};
-    int nr_modules = module_nodes.size();
-
-    std::vector<int> starting_indices={};
-    for(std::string crit : crits){
-        bool found;
-        for(int index = 0; index < module_nodes.size();index++){
-            if(module_nodes.at(index).module_name == crit){
-                starting_indices.push_back(index);
-                break;
-            }
-        }
-    }
-
-    bool *visited = new bool[nr_modules];
-    for(int i = 0; i < nr_modules; i++){
-        visited[i] = false;
-    }
-    std::list<int> queue;
- 
-    for(int s : starting_indices){
-        visited[s] = true;
-        //push all criteria
-        queue.push_back(s);
-    }
-    // 'i' will be used to get all adjacent
-    // vertices of a vertex
-    std::vector<int>::iterator i;
-
-    
-    while(!queue.empty())
-    {
-        int s;
-        s = queue.front();
-        queue.pop_front();
- 
-        for (i = adj_list[s].begin(); i != adj_list[s].end(); ++i)
-        {
-            if (!visited[*i])
-            {
-                visited[*i] = true;
-                queue.push_back(*i);
-            }
-        }
-    }
-
-
-    for(int j=0; j < nr_modules; j++){
-        if(visited[j]){
-            slice.push_back(module_nodes[j]);
-        }
-    }
-
-    return slice;
-}
-
-std::vector<bool> slice_mdg_benchmark(std::vector<std::vector<int>> adj_list, 
-                                        std::vector<Module_node> vertices, 
-                                        std::string crit){
-//return subseteq of module_nodes containing only the module_nodes relevant for module with name crit
-    int nr_modules = vertices.size();
-
-    int starting_index = 0;
-    for(; starting_index < nr_modules; starting_index++){
-        if(vertices.at(starting_index).module_name == crit){
-            break;
-        }
-    }
-
-    std::vector<bool> visited = {};
-    for(int i = 0; i < nr_modules; i++){
-        visited.push_back(false);
-    }
-
-    std::list<int> queue;
- 
-    visited.at(starting_index) = true;
-    queue.push_back(starting_index);
-
-    // 'i' will be used to get all adjacent
-    // vertices of a vertex
-    std::vector<int>::iterator i;
-
-    
-    while(!queue.empty())
-    {
-        int s;
-        s = queue.front();
-        queue.pop_front();
- 
-        for (i = adj_list[s].begin(); i != adj_list[s].end(); ++i)
-        {
-            if (!visited.at(*i))
-            {
-                visited.at(*i) = true;
-                queue.push_back(*i);
-            }
-        }
-    }
-
-    return visited;
-}
-
-void mdg_benchmark(std::vector<Module_node> vertices,
-                   std::vector<std::vector<int>> adj_list,
-                   storm::prism::Program program){
-
-    std::cout << "\n\nStarting MODULE Benchmark\n\n";
-
-    int nr_nodes = vertices.size();
-    int nr_edges = 0;
-    for(std::vector<int> adj_vector : adj_list){
-        nr_edges += adj_vector.size();
-    }
-    int nr_slices = 0;
-
-    //vector of slice sizes to calculate avg slice size
-    int slice_sizes;
-
-    std::map<int, std::vector<std::vector<bool>>> size_by_slices;
-    std::map<int, int> size_by_crits;
-
-
-    for(int index = 0; index < vertices.size(); index++ ){
-        std::string crit;
-        crit = vertices.at(index).module_name;
-        std::vector<bool> visited = slice_mdg_benchmark(adj_list, vertices, crit);
-        int slice_size = std::count(visited.begin(), visited.end(), true);
-        std::map<int, std::vector<std::vector<bool>>>::iterator map_it = size_by_slices.find(slice_size);
-        if(map_it != size_by_slices.end()){
-            size_by_crits[map_it->first] += 1;
-            bool found = false;
-            std::vector<std::vector<bool>> visits_with_same_size = size_by_slices[map_it->first];
-            for(std::vector<bool> visits : visits_with_same_size){
-                bool equal=true;
-                for(int comp = 0; comp < visits.size(); comp++){
-                    if(visits.at(comp) != visited.at(comp)){
-                        equal = false;
-                        break;
-                    }
-                }
-                if(equal){
-                    found=true;
-                    break;
-                }
-            }
-            if(!found){
-                size_by_slices[map_it->first].push_back(visited);
-            }
-        } else {
-            std::vector<std::vector<bool>> new_visits;
-            new_visits.push_back(visited);
-            size_by_slices.insert(std::make_pair(slice_size, new_visits));
-            std::cout<< "new length " << slice_size << " for slice of module: " << vertices.at(index).module_name << std::endl;
-
-            size_by_crits.insert(std::make_pair(slice_size, 1));
-        }
-    }
-
-    int amount_unique_slices = 0;
-    int avg_slice_size = 0;
-    float size_by_unique_sum = 0;
-    float size_by_crits_sum = 0;
-    std::cout<< std::endl;
-    for(std::pair<int, std::vector<std::vector<bool>>> x : size_by_slices) {
-        size_by_unique_sum += x.first * x.second.size();
-        size_by_crits_sum += x.first * size_by_crits[x.first];
-        amount_unique_slices += x.second.size();
-        avg_slice_size += (x.first * x.second.size());
-        std::cout << "got " << x.second.size() << " unique slices with length: " << x.first;
-        std::cout << " produced by " << size_by_crits[x.first] << "/" << vertices.size() << " = " <<static_cast<float>(size_by_crits[x.first])/static_cast<float>(vertices.size()) << " percent of all components" << std::endl;
-    }
-    
-
-    std::cout << "Results: \n";
-    std::cout << "      modules: " << nr_nodes << std::endl;
-    std::cout << "      edges: " << nr_edges << std::endl;
-    std::cout << "      slices: " << amount_unique_slices << std::endl;
-    std::cout << "      avg_size_uw = " << size_by_unique_sum << "/" << static_cast<float>(amount_unique_slices)<< " = " <<  
-        size_by_unique_sum / static_cast<float>(amount_unique_slices) << std::endl;
-    std::cout << "      avg_size_w = " << size_by_crits_sum  << "/" <<  static_cast<float>(vertices.size()) << " = " <<
-        size_by_crits_sum / static_cast<float>(vertices.size()) << std::endl;
-
-
-    
-    // print and test 
-    // res.print();
-
-}
-                   
-
-struct BetterNode {
-    uint_fast64_t identifier;
-    std::string type;
-    std::string module_name;
-    std::set<storm::expressions::Variable> def; //Names of the defined variables
-    std::set<storm::expressions::Variable> ref; //Names of the referenced/declared variables
-    std::string code_segment;
-    void clear(){
-        identifier=-1;
-        type.clear();
-        module_name.clear();
-        def.clear();
-        ref.clear();
-        code_segment.clear();
-    }
-};
-
-std::vector<BetterNode> build_vertices_for_program(storm::prism::Program program){
-    std::vector<BetterNode> verts={};
-    BetterNode ins_node;
-    std::ostringstream code;
-
-    for(auto boolvar : program.getGlobalBooleanVariables()){
-        // Decl Node creation
-        ins_node.clear();
-        ins_node.identifier=boolvar.getExpressionVariable().getIndex(); //global identifier negative 1
-        ins_node.type="decl gb"; //decl global boolean
-        ins_node.module_name="global";
-        boolvar.getExpression().gatherVariables(ins_node.ref);
-        ins_node.ref.insert(boolvar.getExpressionVariable());
-        ins_node.def.insert(boolvar.getExpressionVariable());
-
-        code << "global " << boolvar.getExpressionVariable().getName() << " : bool";
-        if(boolvar.hasInitialValue()){
-            code << " init " << boolvar.getInitialValueExpression().toString();
-            boolvar.getInitialValueExpression().gatherVariables(ins_node.ref);
-        }
-        ins_node.code_segment=  code.str();
-        code.str("");;
-
-        verts.push_back(ins_node);
-
-    }
-
-    for(auto intvar : program.getGlobalIntegerVariables()){
-        // Decl Node creation
-        ins_node.clear();
-        ins_node.identifier=intvar.getExpressionVariable().getIndex(); //global identifier negative 1
-        ins_node.type="decl gi"; //decl global int
-        ins_node.module_name="global";
-        intvar.getExpression().gatherVariables(ins_node.ref);
-        ins_node.ref.insert(intvar.getExpressionVariable());
-        ins_node.def.insert(intvar.getExpressionVariable());
-
-        code << "global " << intvar.getExpressionVariable().getName() << " : ";
-        storm::expressions::Expression rangeexpr = intvar.getRangeExpression();
-        if(rangeexpr.isTrue()){
-            code << "int";
-        } else {
-            code << "[" << intvar.getLowerBoundExpression() << ".." << intvar.getUpperBoundExpression() << "]";
-        }
-        if(intvar.hasInitialValue()){
-            code << " init " << intvar.getInitialValueExpression().toString();
-            intvar.getInitialValueExpression().gatherVariables(ins_node.ref);
-
-        }
-        ins_node.code_segment= code.str();
-        code.str("");;
-        verts.push_back(ins_node);
-    }
-
-    for(auto constant :program.getConstants()){
-        // Decl Node creation
-        ins_node.clear();
-        ins_node.identifier=constant.getExpressionVariable().getIndex(); //global identifier negative 1
-        ins_node.type="decl c"; //decl global constant
-        ins_node.module_name="global";
-        constant.getExpression().gatherVariables(ins_node.ref);
-        ins_node.ref.insert(constant.getExpressionVariable());
-        ins_node.def.insert(constant.getExpressionVariable());
-
-        code << "const ";
-        if(constant.getType().isRationalType()){
-            code << "double"; // storm doesnt know double, it just knows 'rational' which is illegal type in prism
-        } else {
-            code << constant.getType().getStringRepresentation();
-        }
-        code << " " << constant.getExpressionVariable().getName() << " = "; 
-        code << constant.getExpression().toString();
-        ins_node.code_segment= code.str();
-        code.str("");;
-        verts.push_back(ins_node);
-    }
-
-    for(auto form : program.getFormulas()){
-        // Decl Node creation
-        ins_node.clear();
-        ins_node.identifier=form.getExpressionVariable().getIndex(); //global identifier negative 1
-        ins_node.type="decl f"; //decl global formula
-        ins_node.module_name="global";
-        form.getExpression().gatherVariables(ins_node.ref);
-        ins_node.ref.insert(form.getExpressionVariable());
-        ins_node.def.insert(form.getExpressionVariable());
-
-        code << "formula " << form.getExpressionVariable().getName() << " = "; 
-        code << form.getExpression().toString();
-        ins_node.code_segment= code.str();
-        code.str("");
-        verts.push_back(ins_node);
-    }
-
-
-    for(auto module : program.getModules()){
-        for(storm::prism::BooleanVariable boolvar : module.getBooleanVariables()){
-            // Decl Node creation
-            ins_node.clear();
-            ins_node.identifier=boolvar.getExpressionVariable().getIndex(); //global identifier negative 1
-            ins_node.type="decl"; //decl global boolean
-            ins_node.module_name=module.getName();
-            boolvar.getExpression().gatherVariables(ins_node.ref);
-            ins_node.ref.insert(boolvar.getExpressionVariable());
-            ins_node.def.insert(boolvar.getExpressionVariable());
-
-            code << boolvar.getExpressionVariable().getName() << " : bool";
-            if(boolvar.hasInitialValue()){
-                code << " init " << boolvar.getInitialValueExpression().toString();
-                boolvar.getInitialValueExpression().gatherVariables(ins_node.ref);
-            }
-            ins_node.code_segment=  code.str();
-            code.str("");
-
-            verts.push_back(ins_node);
-            }
-
-        for(storm::prism::IntegerVariable intvar : module.getIntegerVariables()){
-
-            storm::expressions::Expression rangeexpr = intvar.getRangeExpression();
-
-            // Decl Node creation
-            ins_node.clear();
-            ins_node.identifier=intvar.getExpressionVariable().getIndex(); //global identifier negative 1
-            ins_node.type="decl"; //decl global boolean
-            ins_node.module_name=module.getName();
-            intvar.getExpression().gatherVariables(ins_node.ref);
-            if(!rangeexpr.isTrue()){
-                intvar.getLowerBoundExpression().gatherVariables(ins_node.ref);
-                intvar.getUpperBoundExpression().gatherVariables(ins_node.ref);
-            }
-
-            ins_node.ref.insert(intvar.getExpressionVariable());
-            ins_node.def.insert(intvar.getExpressionVariable());
-
-            code << intvar.getExpressionVariable().getName() << " : ";
-            if(rangeexpr.isTrue()){
-                code << "int";
-            } else {
-                code << "[" << intvar.getLowerBoundExpression() << ".." << intvar.getUpperBoundExpression() << "]";
-            }
-            if(intvar.hasInitialValue()){
-                code << " init " << intvar.getInitialValueExpression().toString();
-                intvar.getInitialValueExpression().gatherVariables(ins_node.ref);
-
-            }
-            ins_node.code_segment= code.str();
-            code.str("");
-            verts.push_back(ins_node);
-        }
-
-        for(storm::prism::Command c : module.getCommands()){
-
-            // create Guard Node 
-            ins_node.clear();
-            ins_node.identifier=c.getGlobalIndex(); //global identifier negative 1
-            ins_node.type="guard"; //decl global boolean
-            ins_node.module_name=module.getName();
-            c.getGuardExpression().gatherVariables(ins_node.ref);
-            // def = emptyset
-            ins_node.code_segment=c.getGuardExpression().toString();
-
-            verts.push_back(ins_node);
-
-            for(storm::prism::Update u : c.getUpdates()){
-                // create rate Node 
-                ins_node.clear();
-                ins_node.identifier=u.getGlobalIndex(); 
-                ins_node.type="rate"; //decl global boolean
-                ins_node.module_name=module.getName();
-                u.getLikelihoodExpression().gatherVariables(ins_node.ref);
-                // def = emptyset
-                ins_node.code_segment=u.getLikelihoodExpression().toString();
-
-                verts.push_back(ins_node);
-
-                if(u.getAssignments().size() == 0){ // empty assignment -> assignment = 'true'
-                    // create rate Node 
-                    ins_node.clear();
-                    ins_node.identifier=u.getGlobalIndex(); //global identifier negative 1
-                    ins_node.type="assignment"; //decl global boolean
-                    ins_node.module_name=module.getName();
-                    // ref = emptyset
-                    // def = emptyset
-                    ins_node.code_segment="true";
-
-                    verts.push_back(ins_node);
-
-                } else {
-
-                    for(storm::prism::Assignment ass : u.getAssignments()){
-                        // create rate Node 
-                        ins_node.clear();
-                        ins_node.identifier=u.getGlobalIndex(); //global identifier negative 1
-                        ins_node.type="assignment"; //decl global boolean
-                        ins_node.module_name=module.getName();
-                        ass.getExpression().gatherVariables(ins_node.ref);
-                        ins_node.def.insert(ass.getVariable());
-                        code.str("");
-                        code << "(" << ass.getVariable().getExpression().toString() << "'=" << ass.getExpression().toString() << ")";
-                        ins_node.code_segment=code.str();
-                        code.str("");
-
-                        verts.push_back(ins_node);
-                    }
-                }
-                
-                
-
-            }
-
-        }
-        
-
-
-    }
-    if(program.hasInitialConstruct()){
-            ins_node.clear();
-            ins_node.identifier = -1;
-            ins_node.type = "init";
-            ins_node.module_name = "global";
-            program.getInitialStatesExpression().gatherVariables(ins_node.ref);
-            code.str("");
-            code << "init " << program.getInitialStatesExpression().toString() << " endinit";
-            ins_node.code_segment = code.str();
-            verts.push_back(ins_node);
-            code.str("");
-
-        }
-
-    //print and test 
-    // for(BetterNode node : verts){
-    //     std::cout << node.code_segment << ": ";
-    //     std::cout << "{type:" << node.type << ", ID:" << node.identifier << ", Mod: " << node.module_name << ", ref:{";
-    //     for(auto var : node.ref){
-    //         std::cout << var.getName() << ", ";
-    //     }
-    //     std::cout << "}, def:{";
-    //     for(auto var : node.def){
-    //         std::cout << var.getName() << ", ";
-    //     }
-    //     std::cout << "}}" << std::endl;
-    // }
-    // std::cout<< "Amount of vertices = " << verts.size() << std::endl;
-
-    return verts;
-}
-
-std::string get_action_of_guard_node(storm::prism::Program program, BetterNode guard){
-    std::string action;
-    std::unordered_map< uint_fast64_t, std::string> cid_to_action = program.buildCommandIndexToActionNameMap();
-    action = cid_to_action[guard.identifier];
-    return action;
-}
-
-std::vector<BetterNode> get_all_guard_nodes(std::vector<BetterNode> inputnodes){
-    std::vector<BetterNode> guards;
-    for(BetterNode node : inputnodes){
-        if(node.type == "guard"){
-            guards.push_back(node);
-        }
-    }
-    return guards;
-}
-
-std::vector<BetterNode> get_assignment_nodes_for_guard(storm::prism::Program program, std::vector<BetterNode> vertices, BetterNode guard){
-    if(!(guard.type=="guard")){
-        throw std::invalid_argument( "given node is not of type guard" );
-    }
-    std::vector<BetterNode> assignments;
-    storm::prism::Module mod = program.getModule(guard.module_name);
-    storm::prism::Command com;
-    for(auto command : mod.getCommands()){
-        if(command.getGlobalIndex() == guard.identifier){ com = command;}
-    }
-    for(storm::prism::Update u : com.getUpdates()){
-        for(auto node : vertices){
-            if((node.identifier == u.getGlobalIndex()) && (node.type=="assignment")){
-                assignments.push_back(node);
-            }
-        }
-    }
-    //print and check 
-    // std::cout<< "guard " << guard.code_segment << " is related to assingments:";
-    // for(auto assg : assignments){
-    //     std::cout << assg.type << " " << assg.code_segment;
-    // }
-    // std::cout << " | " << std::endl;
-    return assignments;
-}
-
-std::unordered_map<uint_fast64_t, uint_fast64_t> build_assgID_to_comID_map(std::vector<BetterNode> vertices, storm::prism::Program program){
-    
-    std::unordered_map<uint_fast64_t, uint_fast64_t> assgID_to_comID_map;
-
-    std::vector<BetterNode> guards = get_all_guard_nodes(vertices);
-
-    for(BetterNode guard : guards){
-        storm::prism::Module mod = program.getModule(guard.module_name);                                                                                                            //but node ID is global command index 
-        storm::prism::Command com;
-        for(auto command : mod.getCommands()){
-            if(command.getGlobalIndex() == guard.identifier){ com = command;}
-        }
-
-        for(storm::prism::Update u : com.getUpdates()){
-            uint_fast64_t glob_index = u.getGlobalIndex();
-            for(int i = 0; i < vertices.size(); i++){
-                if((vertices.at(i).identifier == glob_index) && (vertices.at(i).type=="assignment")){
-                    assgID_to_comID_map[vertices.at(i).identifier] = guard.identifier;
-                }
-            }
-        }
-    }
-    return assgID_to_comID_map;
-}
-
-
-bool depgg(BetterNode v1, BetterNode v2, std::unordered_map< uint_fast64_t, std::string> cid_to_action){
-    if(v1.type=="guard" && v2.type=="guard"){
-        if(v1.module_name != v2.module_name){
-            if(cid_to_action[v1.identifier].size() > 0){
-                if(cid_to_action[v1.identifier] == cid_to_action[v2.identifier]){
-                    return true;
-                }
-            }
-        }
-
-    }
-    return false;
-}
-
-bool depag(BetterNode v1, BetterNode v2, std::unordered_map<uint_fast64_t, uint_fast64_t> aID_to_cID){
-    if(v1.type == "assignment" || v1.type == "rate"){
-        if(v2.type == "guard"){
-            if(aID_to_cID[v1.identifier] == v2.identifier){
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-bool depar(BetterNode v1, BetterNode v2){
-    if(v1.identifier == v2.identifier){
-        if(v1.type == "assignment"){
-            if(v2.type == "rate"){
-                return true;
-            }
-        }
-    }
-    return false;
-    // return ((v1_assg && v2_rate) || (v1_rate && v2_assg)) && related;
-}
-
-
-bool depdi(BetterNode v1, BetterNode v2){
-    if(v1.type.find("decl") != std::string::npos){//type contains 'decl'?
-        if(v2.type == "init"){
-            bool v1_adressed_in_v2 = false;
-            for(storm::expressions::Variable decl_var : v1.def){
-                for(storm::expressions::Variable init_var : v2.ref){
-                    if(decl_var.getName() == init_var.getName()){
-                        return true;
-                    }
-                }
-            }
-        }
-    } 
-    return false;
-}
-
-std::vector<std::vector<int>> build_comp_adj_list(std::vector<BetterNode> vertices, storm::prism::Program program){
-    std::vector<std::vector<int>> comp_adj_list;
-    comp_adj_list.reserve(vertices.size());
-
-    std::unordered_map< uint_fast64_t, std::string> cid_to_action = program.buildCommandIndexToActionNameMap();
-    std::unordered_map<uint_fast64_t, uint_fast64_t> aID_to_cID = build_assgID_to_comID_map(vertices, program);
-
-    for(int i = 0; i < vertices.size(); i++){
-        std::vector<int> adj_vector={};
-        for(int j = 0; j < vertices.size(); j++){
-            if(i==j) {continue;}
-            // cdep 
-            //      depar 
-            if ( depar(vertices.at(i), vertices.at(j)) ){
-                adj_vector.push_back(j);
 
-                continue;
-            }
-
-            //      depgg
-            if( depgg(vertices.at(i), vertices.at(j), cid_to_action) ){
-                adj_vector.push_back(j);
-
-                continue;
-            }
-            //      depag
-            if( depag(vertices.at(i), vertices.at(j), aID_to_cID)){
-                adj_vector.push_back(j);
-
-                continue;
-            }
-            
-
-            // ddep
-            bool transition = false;
-
-            //ddep ref(vertices[i]) setintersection def(vertices[j]) != emptyset
-            for(Variable vari : vertices.at(i).ref){
-                for(Variable varj : vertices.at(j).def){
-                    if(vari.getName() == varj.getName()){
-                        adj_vector.push_back(j);
-                        // std::cout << "added ddep trans for: " << vertices.at(i).code_segment;
-                        // std::cout << " and " << vertices.at(j).code_segment <<std::endl;
-                        transition = true;
-                        break;
-                    }
-                }
-                if(transition) {break;}
-            }
-        }
-        comp_adj_list.push_back(adj_vector);
-        // std::cout<< "built adjacency vector for comp " << vertices.at(i).code_segment << std::endl;
+// builds the model of a sliced program and checks the properties on it
+void check_slice(storm::prism::Program const& sliced_program, std::vector<storm::jani::Property> const& properties){
+    PRISL_TRACE_BEGIN(build_span, "build", "model build");
+    std::shared_ptr<storm::models::sparse::Model<double>> model =
+        storm::api::buildSparseModel<double>(sliced_program, storm::api::extractFormulasFromProperties(properties));
+    PRISL_TRACE_END(build_span);
+    std::cout << "  slice model: " << model->getNumberOfStates() << " states, " << model->getNumberOfTransitions() << " transitions" << std::endl;
+    for(storm::jani::Property const& property : properties){
+        std::unique_ptr<storm::modelchecker::CheckResult> result =
+            storm::api::verifyWithSparseEngine<double>(model, storm::api::createTask<double>(property.getRawFormula(), true));
+        std::cout << "  " << property.getName() << ": " << *result << std::endl;
     }
-    return comp_adj_list;
-
 }
 
-void check_slice_for_useless_commands(std::vector<BetterNode> &vertices, storm::prism::Program program){ //checks if something can be sliced away after slicing
-    for(storm::prism::Module module : program.getModules()){
-            bool module_relevant = false;
-            //check if this module is in vertices:
-            for(auto node : vertices){
-                if(node.module_name == module.getName()){
-                    module_relevant=true;
-                    break;
-                }
-            }
-            if(!module_relevant) { continue;}
-
-        for(storm::prism::Command c : module.getCommands()){
-                // is command in slice and guard true?
-                bool relevant_guard_is_true = false; //relevant if guard is inside nodes
-                std::vector<BetterNode>::iterator nodeptr;
-                for(nodeptr = vertices.begin(); nodeptr < vertices.end(); nodeptr++){
-                    if( (nodeptr->type == "guard") && c.getGuardExpression().isTrue() && (nodeptr->identifier == c.getGlobalIndex()) ){
-                        relevant_guard_is_true = true;
-                        break;
-                    }
-                }
-                if(!relevant_guard_is_true) {continue;}
-
-                //if no updates and guard.getExpression.isTrue
-                int update_counter=0;
-                for(storm::prism::Update u : c.getUpdates()){
-                    for(auto ratenode : vertices){
-                        if( (ratenode.identifier==u.getGlobalIndex()) && (ratenode.type=="rate") ){
-                            update_counter+=1;
-                        }
-                    }
-                }
-
-                if(update_counter==0){
-                    vertices.erase(nodeptr);
-                    continue;
-                }
-        }
-    }
-}
-
-std::vector<BetterNode> slice_cdg_by_comp(  std::vector<BetterNode> vertices, 
-                                            std::vector<std::vector<int>> adj_list, 
-                                            std::vector<std::string> crits,
-                                            storm::prism::Program program){
-    std::vector<BetterNode> slice={};
-    //find module with given name
-    int nr_verts = vertices.size();
-    // make s array for multiple starting points
-    
-    std::vector<int> starting_indices={};
-    for(std::string crit : crits){
-        int index = 0;
-        for(; index < vertices.size();index++){
-            if(vertices.at(index).code_segment == crit){
-                starting_indices.push_back(index);
-                break;
-            }
-        }
-        if(index == vertices.size()){
-            std::ostringstream error;
-            error << "component " << crit << " not found";
-            throw std::invalid_argument( error.str() );
-        }
-    }
-
-    bool *visited = new bool[nr_verts];
-    for(int i = 0; i < nr_verts; i++){
-        visited[i] = false;
-    }
-    std::list<int> queue;
- 
-    for(int s : starting_indices){
-        visited[s] = true;
-        //push all criteria
-        queue.push_back(s);
-    }
-    std::vector<int>::iterator i;
-    int s;
-    while(!queue.empty())
-    {
-        s = queue.front();
-        queue.pop_front();
- 
-        for (i = adj_list[s].begin(); i != adj_list[s].end(); ++i)
-        {
-            if (!visited[*i])
-            {
-                visited[*i] = true;
-                queue.push_back(*i);
-            }
-        }
-    }
-
-
-    for(int j=0; j < nr_verts; j++){
-        if(visited[j]){
-            slice.push_back(vertices.at(j));
-        }
-    }
-
-    check_slice_for_useless_commands(slice,program);
-
-    return slice;
-}
-
-std::vector<bool> slice_cdg_benchmark(  std::vector<BetterNode> vertices, 
-                                            std::vector<std::vector<int>> adj_list, 
-                                            std::vector<std::string> crits,
-                                            storm::prism::Program program){
-    std::vector<BetterNode> slice={};
-    //find module with given name
-    int nr_verts = vertices.size();
-    // make s array for multiple starting points
-    
-    std::vector<int> starting_indices={};
-    for(std::string crit : crits){
-        int index = 0;
-        for(; index < vertices.size();index++){
-            if(vertices.at(index).code_segment == crit){
-                starting_indices.push_back(index);
-                break;
-            }
-        }
-        if(index == vertices.size()){
-            std::ostringstream error;
-            error << "component " << crit << " not found";
-            throw std::invalid_argument( error.str() );
-        }
-    }
-
-    std::vector<bool> visited = {};
-    for(int i = 0; i < nr_verts; i++){
-        visited.push_back(false);
-    }
-    std::list<int> queue;
- 
-    for(int s : starting_indices){
-        visited[s] = true;
-        //push all criteria
-        queue.push_back(s);
-    }
-    std::vector<int>::iterator i;
-    int s;
-    while(!queue.empty())
-    {
-        s = queue.front();
-        queue.pop_front();
- 
-        for (i = adj_list[s].begin(); i != adj_list[s].end(); ++i)
-        {
-            if (!visited[*i])
-            {
-                visited[*i] = true;
-                queue.push_back(*i);
-            }
-        }
-    }
-
-    for(int j=0; j < nr_verts; j++){
-        if(visited[j]){
-            slice.push_back(vertices.at(j));
-        }
-    }
-
-    check_slice_for_useless_commands(slice,program);
-
-
-    return visited;
-}
-
-
-void write_prism_from_vertices(std::vector<BetterNode> vertices, storm::prism::Program program, std::string path= "slice.prism"){
-    std::ofstream prismfile;
-    prismfile.open(path);
-    if(prismfile.is_open()){
-        //for globals
-        switch (program.getModelType())
-        {
-            case storm::prism::Program::ModelType::DTMC:
-                prismfile << "dtmc\n\n"; 
-                break;
-            case storm::prism::Program::ModelType::MDP:
-                prismfile << "mdp\n\n"; 
-                break;
-            case storm::prism::Program::ModelType::CTMC:
-                prismfile << "ctmc\n\n"; 
-                break;
-            case storm::prism::Program::ModelType::CTMDP :
-                prismfile << "ctmdp\n\n"; 
-                break;
-            case storm::prism::Program::ModelType::MA :
-                prismfile << "ma\n\n"; 
-                break;
-            case storm::prism::Program::ModelType::POMDP :
-                prismfile << "pomdp\n\n"; 
-                break;
-            case storm::prism::Program::ModelType::PTA :
-                prismfile << "pta\n\n"; 
-                break;
-            case storm::prism::Program::ModelType::SMG  :
-                prismfile << "smg\n\n"; 
-                break;
-            default:
-                prismfile << "mdp\n\n";
-        }
-
-        for(auto boolvar : program.getGlobalBooleanVariables()){
-            for(BetterNode node : vertices){
-                bool found = false;
-                if(node.type=="decl gb"){
-                    for(auto v : node.def){
-                        if(v.getName() == boolvar.getName()){
-                            prismfile << node.code_segment << ";\n";
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                if(found) { break;}
-            }
-        }
-        for(auto intvar : program.getGlobalIntegerVariables()){
-            for(BetterNode node : vertices){
-                bool found = false;
-                if(node.type=="decl gi"){
-                    for(auto v : node.def){
-                        if(v.getName() == intvar.getName()){
-                            prismfile << node.code_segment << ";\n";
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                if(found) { break;}
-            }
-        }
-        for(auto constant : program.getConstants()){
-            for(BetterNode node : vertices){
-                bool found = false;
-                if(node.type=="decl c"){
-                    for(auto v : node.def){
-                        if(v.getName() == constant.getName()){
-                            prismfile << node.code_segment << ";\n";
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                if(found) { break;}
-            }
-        }
-        for(auto formula : program.getFormulas()){
-            for(BetterNode node : vertices){
-                bool found = false;
-                if(node.type=="decl f"){
-                    for(auto v : node.def){
-                        if(v.getName() == formula.getName()){
-                            prismfile << node.code_segment << ";\n";
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                if(found) { break;}
-            }
-        }
-        prismfile << "\n";
-        for(storm::prism::Module module : program.getModules()){
-            bool module_relevant = false;
-            //check if this module is in vertices:
-            for(auto node : vertices){
-                if(node.module_name == module.getName()){
-                    module_relevant=true;
-                    break;
-                }
-            }
-            if(!module_relevant) { continue;}
-            prismfile << "module " << module.getName() << "\n";
-
-            for(storm::prism::BooleanVariable boolvar : module.getBooleanVariables()){
-                for(BetterNode node : vertices){
-                bool found = false;
-                if( (node.type=="decl") && (node.module_name== module.getName()) ){
-                    for(auto v : node.def){
-                        if(v.getName() == boolvar.getName()){
-                            prismfile << "  " << node.code_segment << ";\n";
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                if(found) { break;}
-            }
-            }
-
-            for(storm::prism::IntegerVariable intvar : module.getIntegerVariables()){
-                for(BetterNode node : vertices){
-                    bool found = false;
-                    if( (node.type=="decl") && (node.module_name== module.getName()) ){
-                        for(auto v : node.def){
-                            if(v.getName() == intvar.getName()){
-                                prismfile << "  " << node.code_segment << ";\n";
-                                found = true;
-                                break;
-                            }
-                        }
-                    }
-                    if(found) { break;}
-                }
-            }
-
-            for(storm::prism::Command c : module.getCommands()){
-                // is command relevant?
-                bool command_relevant = false; //relevant if guard is inside nodes
-                for(auto node : vertices){
-                    if( (node.type == "guard") && (node.identifier == c.getGlobalIndex()) ){
-                        prismfile << "  [" << get_action_of_guard_node(program, node) << "] " << node.code_segment << " -> ";
-                        command_relevant = true;
-                        break;
-                    }
-                }
-                if(!command_relevant) {continue;}
-
-                //are the this commands updates empty in slice? -> updatecounter==0
-                //we need the amount of updates to know if update is followed by '+' or by ';'
-                int update_counter=0;
-                for(storm::prism::Update u : c.getUpdates()){
-                    for(auto ratenode : vertices){
-                        if( (ratenode.identifier==u.getGlobalIndex()) && (ratenode.type=="rate") ){
-                            update_counter+=1;
-                        }
-                    }
-                }
-
-                if(update_counter==0){
-                    prismfile << "true;\n";
-                    continue;
-                }
-
-                // if we are here, then there are some updates of c contained in the slice 
-                // now we need to take all updates of the original command 
-                update_counter = c.getNumberOfUpdates();
-                
-                // and check if an update is in the slice
-                    //if update in slice: write down rate and the assignments contained in the slice
-                    //if update not in slice: write down rate and assignment "true"
-
-                for(storm::prism::Update u : c.getUpdates()){
-                    bool update_in_slice = false;
-                    for(auto ratenode : vertices){
-                        if( (ratenode.identifier==u.getGlobalIndex()) && (ratenode.type=="rate") ){
-                            update_counter -=1;
-                            update_in_slice = true;
-                            prismfile << ratenode.code_segment << ":";
-                            int assgs_left = 0; // we need to know the amount of assignments coming to know which one is the last (is not followed by '&')
-                            for(auto assgnode : vertices){
-                                if( (assgnode.identifier==u.getGlobalIndex()) && (assgnode.type=="assignment") ){
-                                    assgs_left += 1;
-                                }
-                            }
-                            for(auto assgnode : vertices){
-                                if( (assgnode.identifier==u.getGlobalIndex()) && (assgnode.type=="assignment") ){
-                                    if(assgs_left > 1){
-                                        prismfile << assgnode.code_segment << "&";
-                                        assgs_left -=1;
-                                    } else if(assgs_left == 1) {
-                                        prismfile << assgnode.code_segment;
-                                    }
-                                }
-                            }
-                            
-                        }
-                    }
-                    if(!update_in_slice){
-                        prismfile << u.getLikelihoodExpression().toString() <<": true";
-                        update_counter -=1;
-                    }
-                    // add plus or ;?
-                    if(update_counter == 0){
-                        prismfile << ";\n"; //end of command
-                    } else {
-                        prismfile << " + ";
-                    }
-
-                }
-
-            }
-            prismfile << "endmodule\n\n";
-
-            
-        }
-        if(program.hasInitialConstruct()){
-            for (unsigned k = vertices.size(); k-- != 0; ) { 
-                if(vertices.at(k).type == "init"){
-                    prismfile << vertices.at(k).code_segment << "\n";
-                }
-            }
-        }
-        
-        prismfile.close();
-
+// the vertex table and the search graph of a slicer
+void add_slicer_memory(MemoryReport &mem_report, Slicer const& slicer){
+    mem_report.add_vertices(slicer.vertices(), slicer.arena_upstream());
+    if(slicer.hybrid_adj_list() != nullptr){
+        mem_report.add("hybrid_adj_list", slicer.hybrid_adj_list()->bytes());
     } else {
-        std::cout << "Unable to open file" <<std::endl;
-        return;
+        mem_report.add("adj_list", adj_list_bytes(slicer.adj_list()));
     }
-    
-
 }
 
-struct Result {
-    int nodes;
-    int edges;
-    int slices;
-    float avg_size_w;
-    float avg_size_uw;
-
-    void print(){
-        std::cout << "Results:\n";
-        std::cout << "      nodes: " << nodes << "\n";
-        std::cout << "      edges: " << edges << "\n";
-        std::cout << "      slices: " << slices << "\n";
-        std::cout << "      avg_size unweighted: " << avg_size_uw << "\n";
-        std::cout << "      avg_size weighted: " << avg_size_w << "\n";
-
-    }
-};
-
-Result benchmark(std::vector<BetterNode> vertices,
-                 std::vector<std::vector<int>> adj_list,
-                  storm::prism::Program program){
-    Result res;
-    std::cout << "\n\nStarting COMPONENTS Benchmark\n\n";
-    res.nodes = vertices.size();
-    res.edges = 0;
-
-    for(std::vector<int> adj_vector : adj_list){
-        res.edges += adj_vector.size();
-    }
-    res.slices = 0;
-
-    //vector of slice sizes to calculate avg slice size
-    int slice_sizes;
-
-
-    std::map<int, std::vector<std::vector<bool>>> size_by_slices;
-    std::map<int, int> size_by_crits;
+int main (int argc, char *argv[]) {
 
+    // Init loggers
+    storm::utility::setUp();
+    // Set some settings objects.
+    storm::settings::initializeAll("prisl", "prisl");
 
-    for(int index = 0; index < vertices.size(); index++ ){
-        std::vector<std::string> crit;
-        crit.push_back(vertices.at(index).code_segment);
-        std::vector<bool> visited = slice_cdg_benchmark(vertices, adj_list, crit, program);
-        int slice_size = std::count(visited.begin(), visited.end(), true);
-        std::map<int, std::vector<std::vector<bool>>>::iterator map_it = size_by_slices.find(slice_size);
-        if(map_it != size_by_slices.end()){
-            size_by_crits[map_it->first] += 1;
-            bool found = false;
-            std::vector<std::vector<bool>> visits_with_same_size = size_by_slices[map_it->first];
-            for(std::vector<bool> visits : visits_with_same_size){
-                bool equal=true;
-                for(int comp = 0; comp < visits.size(); comp++){
-                    if(visits.at(comp) != visited.at(comp)){
-                        equal = false;
-                        break;
-                    }
-                }
-                if(equal){
-                    found=true;
-                    break;
-                }
-            }
-            if(!found){
-                size_by_slices[map_it->first].push_back(visited);
-            }
+    // options can be given anywhere, everything else is positional
+    MemoryReport mem_report;
+    bool joint = false; // one slice for all properties instead of one per property
+    std::string constants; // definitions of undefined constants, f.e. 'N=3,K=2'
+    bool smt = false; // prune synchronization edges between guards that cannot hold together
+    double threshold = 0.25; // allowed slowdown of a corpus run against its baseline
+    bool write_baseline = false;
+    std::string trace_path; // Chrome trace-event JSON of the run
+    EdgeKinds deps = DEP_DEFAULT; // dependence kinds the slices follow
+    bool symmetry = false; // benchmark module copies through their representative
+    bool build = false; // build the model of a slice in memory, without writing and parsing it again
+    bool emit = true; // write the slices as PRISM files
+    VertexOrder order = VertexOrder::program; // numbering of the graph for the searches
+    bool hybrid = false; // bitmap rows for the hubs of the graph
+    double merge_budget = 0; // growth allowed when plan merges near-equal slices
+    std::vector<char*> positional;
+    for(int i = 0; i < argc; i++){
+        std::string arg = std::string(argv[i]);
+        if(arg == "--mem"){
+            mem_report.enabled = true;
+        } else if(arg == "--threshold" && i + 1 < argc){
+            threshold = std::stod(argv[++i]);
+        } else if(arg == "--write-baseline"){
+            write_baseline = true;
+        } else if(arg == "--trace" && i + 1 < argc){
+            trace_path = argv[++i];
+            Tracer::instance().enabled = true;
+        } else if(arg == "-deps" && i + 1 < argc){
+            deps = parse_dependence_kinds(argv[++i]);
+        } else if(arg == "--symmetry"){
+            symmetry = true;
+        } else if(arg == "--build"){
+            build = true;
+        } else if(arg == "--no-emit"){
+            emit = false;
+        } else if(arg == "--hybrid"){
+            hybrid = true;
+        } else if(arg == "-order" && i + 1 < argc){
+            order = parse_vertex_order(argv[++i]);
+        } else if(arg == "--merge-budget" && i + 1 < argc){
+            merge_budget = std::stod(argv[++i]);
+        } else if(arg == "--smt"){
+            smt = true;
+        } else if(arg == "--joint"){
+            joint = true;
+        } else if((arg == "-const" || arg == "--const") && i + 1 < argc){
+            constants = argv[++i];
+        } else if(arg == "--mem-json" && i + 1 < argc){
+            mem_report.enabled = true;
+            mem_report.json_path = argv[++i];
         } else {
-            std::vector<std::vector<bool>> new_visits;
-            new_visits.push_back(visited);
-            size_by_slices.insert(std::make_pair(slice_size, new_visits));
-            std::cout<< "new length " << slice_size << " for slice of component: " << vertices.at(index).code_segment << std::endl;
-            size_by_crits.insert(std::make_pair(slice_size, 1));
+            positional.push_back(argv[i]);
         }
     }
+    argc = positional.size();
+    argv = positional.data();
+    Slicer::Options options;
+    options.deps = deps;
+    options.smt = smt;
+    options.order = order;
+    options.hybrid = hybrid;
 
-    int amount_unique_slices = 0;
-    int avg_slice_size = 0;
-    float size_by_unique_sum = 0;
-    float size_by_crits_sum = 0;
-    std::cout << std::endl;
-    for(std::pair<int, std::vector<std::vector<bool>>> x : size_by_slices) {
-        size_by_unique_sum += x.first * x.second.size();
-        size_by_crits_sum += x.first * size_by_crits[x.first];
-        amount_unique_slices += x.second.size();
-        avg_slice_size += (x.first * x.second.size());
-        std::cout << "got " << x.second.size() << " unique slices with length: " << x.first;
-        std::cout << " produced by " << size_by_crits[x.first] << "/" << vertices.size() << " = " <<static_cast<float>(size_by_crits[x.first])/static_cast<float>(vertices.size()) << " percent of all components" << std::endl;
-
- 
+    // the modes that do not search a slicer's graph cannot renumber it
+    std::string mode_name = argc > 2 ? std::string(argv[2]) : std::string();
+    if((mode_name == "corpus" || mode_name == "parse") && order != VertexOrder::program){
+        throw std::invalid_argument( "-order has no effect in " + mode_name + " mode" );
     }
-
-
-    res.slices = amount_unique_slices;
-    if(amount_unique_slices != 0){
-        res.avg_size_uw = (size_by_unique_sum/static_cast<float>(amount_unique_slices));
-        res.avg_size_w = size_by_crits_sum / static_cast<float>(vertices.size());
+    if((mode_name == "corpus" || mode_name == "parse") && hybrid){
+        throw std::invalid_argument( "--hybrid has no effect in " + mode_name + " mode" );
     }
 
-    
-    // print and test 
-    res.print();
-
-    return res;
-}
-
-int main (int argc, char *argv[]) {
-
-    // Init loggers
-    storm::utility::setUp();
-    // Set some settings objects.
-    storm::settings::initializeAll("prisl", "prisl");
-
     // Call function
-    if(argc == 3 && std::string(argv[2]) == "b" ){
+    if((argc == 3 || argc == 4) && std::string(argv[2]) == "corpus"){
+        // argv[1] is a directory of models, argv[3] the baseline file
+        std::string baseline_path = argc == 4 ? std::string(argv[3]) : (std::filesystem::path(argv[1]) / "baseline.txt").string();
+        int failures = run_corpus(argv[1], baseline_path, threshold, write_baseline, smt);
+        Tracer::instance().write(trace_path);
+        return failures == 0 ? 0 : 1;
+    }
+    else if(argc > 4 && std::string(argv[2]) == "batch"){
+        // argv[1] is a directory of models, all of them are sliced for TYPE CRIT...
+        int failures = run_batch(argv[1], argv[3], std::vector<std::string>(argv + 4, argv + argc), constants, options);
+        Tracer::instance().write(trace_path);
+        return failures == 0 ? 0 : 1;
+    }
+    else if(argc == 3 && std::string(argv[2]) == "b" ){
 
     // unsync the I/O of C and C++.
     std::ios_base::sync_with_stdio(false);
@@ -1442,148 +155,357 @@ int main (int argc, char *argv[]) {
         //CDG BENCHMARK
 
         auto start = std::chrono::high_resolution_clock::now();
+        PRISL_TRACE_BEGIN(parse_span, "parse", "parse");
         storm::prism::Program program = storm::parser::PrismParser::parse(argv[1]);
-        std::vector<BetterNode> vertices = build_vertices_for_program(program);
-        std::vector<std::vector<int>> adj_list = build_comp_adj_list(vertices, program);\
+        if(!constants.empty()){
+            program = instantiate_constants(program, constants);
+        }
+        PRISL_TRACE_END(parse_span);
+        mem_report.phase("parse");
+        mem_report.add("program", program_bytes(program));
+        // the graph the slicing modes search, with -deps, --smt, -order and --hybrid
+        Slicer slicer = Slicer::load(std::move(program), options, &mem_report);
+        if(smt){
+            std::cout << "smt pruning: " << slicer.smt_pruned_pairs() << " of " << slicer.smt_checks() << " checked guard pairs can never synchronize\n";
+        }
         double time_taken_building = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
         double building_in_seconds = time_taken_building * 1e-9;
         time_taken_building *= 1e-6;
         start = std::chrono::high_resolution_clock::now();
-        benchmark(vertices, adj_list, program);
+        Result res = benchmark(slicer, true, symmetry);
         auto end = std::chrono::high_resolution_clock::now();
+        mem_report.phase("slicing");
+        add_slicer_memory(mem_report, slicer);
+        mem_report.add("unique_slices", res.slice_store_bytes);
         double time_taken = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
         double slicing_in_seconds = time_taken * 1e-9;
         time_taken *= 1e-3;
         std::cout << "building cdg took: " << building_in_seconds << std::setprecision(9) << "seconds \n";
         std::cout << "slicing took avg time of " 
-            << std::fixed << slicing_in_seconds/static_cast<float>(vertices.size()) << std::setprecision(9) << " seconds\n";
+            << std::fixed << slicing_in_seconds/static_cast<float>(slicer.vertices().size()) << std::setprecision(9) << " seconds\n";
 
 
         //MDG BENCHMARK
     
+        // derived from the component graph, no second parse
+        std::vector<std::vector<int>> adj_list = slicer.program_adj_list();
         start = std::chrono::high_resolution_clock::now();
-        program = storm::parser::PrismParser::parse(argv[1]);
-        std::vector<Module_node> module_vertices = get_module_nodes(program);
-        std::vector<std::vector<int>> mdg_adj_list = create_adj_list(module_vertices);
+        std::vector<Module_node> module_vertices = get_module_nodes(slicer.vertices(), slicer.program());
+        std::vector<std::vector<int>> mdg_adj_list = quotient_adj_list(slicer.vertices(), adj_list, module_vertices);
         time_taken_building = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
         time_taken_building *=1e-9;
 
         start = std::chrono::high_resolution_clock::now();
-        mdg_benchmark(module_vertices, mdg_adj_list, program);
+        mdg_benchmark(module_vertices, mdg_adj_list, slicer.program());
         end = std::chrono::high_resolution_clock::now();
+        mem_report.phase("module slicing");
+        mem_report.add("mdg_adj_list", adj_list_bytes(mdg_adj_list));
         time_taken = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();;
         time_taken *= 1e-9;
         std::cout << "building mdg took: " << time_taken_building << "seconds \n";
         std::cout << "slicing took avg time of " 
             << std::fixed << time_taken/static_cast<float>(module_vertices.size()) << std::setprecision(9) << " seconds per slice \n";
     }
+    else if(argc == 3 && std::string(argv[2]) == "stats"){
+        PRISL_TRACE_BEGIN(parse_span, "parse", "parse");
+        storm::prism::Program program = storm::parser::PrismParser::parse(argv[1], true);
+        if(!constants.empty()){
+            program = instantiate_constants(program, constants);
+        }
+        PRISL_TRACE_END(parse_span);
+        mem_report.phase("parse");
+        mem_report.add("program", program_bytes(program));
+        // the kinds of every edge of the graph the slices would use
+        Slicer::Options stats_options = options;
+        stats_options.edge_kinds = true;
+        Slicer slicer = Slicer::load(std::move(program), stats_options, &mem_report);
+        graph_stats(slicer.vertices(), slicer.dependences(), slicer.edge_kinds()).print(slicer.vertices(), std::cout);
+        mem_report.add_vertices(slicer.vertices(), slicer.arena_upstream());
+        mem_report.add("adj_list", adj_list_bytes(slicer.dependences()));
+    }
+    else if(argc == 3 && std::string(argv[2]) == "session"){
+        // interactive: criteria are added and removed line by line from stdin
+        PRISL_TRACE_BEGIN(parse_span, "parse", "parse");
+        storm::prism::Program program = storm::parser::PrismParser::parse(argv[1], true);
+        if(!constants.empty()){
+            program = instantiate_constants(program, constants);
+        }
+        PRISL_TRACE_END(parse_span);
+        mem_report.phase("parse");
+        Slicer slicer = Slicer::load(std::move(program), options, &mem_report);
+        SliceSession session(slicer);
+
+        std::cout << "+ TYPE CRIT... adds, - TYPE CRIT... removes criteria, w [FILE] writes the slice, q quits" << std::endl;
+        std::string line;
+        while(std::getline(std::cin, line)){
+            std::istringstream words(line);
+            std::string command;
+            std::string type;
+            words >> command;
+            if(command.empty()){ continue;}
+            if(command == "q" || command == "quit"){ break;}
+            if(command == "w" || command == "write"){
+                std::string path = "slice.prism";
+                words >> path;
+                write_prism_from_vertices(session.result().components, slicer.program(), path);
+                std::cout << "written to " << path << std::endl;
+                continue;
+            }
+            if((command != "+" && command != "-") || !(words >> type)){
+                std::cout << "expected + TYPE CRIT..., - TYPE CRIT..., w [FILE] or q" << std::endl;
+                continue;
+            }
+            std::vector<std::string> crits;
+            std::string crit;
+            while(words >> std::quoted(crit)){
+                crits.push_back(crit);
+            }
+            try {
+                std::vector<int> vertices = slicer.criteria(type, crits);
+                if(command == "+"){
+                    session.add(vertices);
+                } else {
+                    session.remove(vertices);
+                }
+            } catch(std::invalid_argument const& e){
+                std::cout << e.what() << std::endl;
+                continue;
+            }
+            std::cout << session.criteria().size() << " criteria, " << session.size() << "/" << slicer.vertices().size()
+                      << " components" << std::endl;
+        }
+        mem_report.phase("slicing");
+        mem_report.add_vertices(slicer.vertices(), slicer.arena_upstream());
+    }
     else if(argc == 3 && std::string(argv[2]) == "parse"){
+        PRISL_TRACE_BEGIN(parse_span, "parse", "parse");
         storm::prism::Program program = storm::parser::PrismParser::parse(argv[1], true);
-        std::vector<BetterNode> vertices = build_vertices_for_program(program);
+        if(!constants.empty()){
+            program = instantiate_constants(program, constants);
+        }
+        PRISL_TRACE_END(parse_span);
+        mem_report.phase("parse");
+        mem_report.add("program", program_bytes(program));
+        CountingResource arena_upstream;
+        std::pmr::monotonic_buffer_resource vertex_arena(&arena_upstream);
+        Vertices vertices = build_vertices_for_program(program, &vertex_arena);
+        mem_report.phase("vertex build");
         write_prism_from_vertices(vertices, program);
+        mem_report.add_vertices(vertices, arena_upstream);
     }
     else if(argc > 3){
-        storm::prism::Program program = storm::parser::PrismParser::parse(argv[1], true);
-
-        std::vector<BetterNode> vertices = build_vertices_for_program(program);
+        PRISL_TRACE_BEGIN(parse_span, "parse", "parse");
+        storm::prism::Program parsed_program = storm::parser::PrismParser::parse(argv[1], true);
+        if(!constants.empty()){
+            parsed_program = instantiate_constants(parsed_program, constants);
+        }
+        PRISL_TRACE_END(parse_span);
+        mem_report.phase("parse");
+        mem_report.add("program", program_bytes(parsed_program));
 
-        // crit must be the code snippet of some vertex\in vertices OR Variable OR Module
+        // every mode slices through the library API, so -deps, --smt, -order and --hybrid apply to all of them
         std::string mode = std::string(argv[2]);
-        if(mode=="v" || mode=="variable" || mode=="var"){
-
-            std::vector<std::string> crits={};
-
-            bool legal_crit = true;
+        Slicer::Options mode_options = options;
+        if(mode == "deps"){
+            // one graph with every kind, masked per benchmark
+            mode_options.deps = DEP_ALL;
+            mode_options.edge_kinds = true;
+        }
+        Slicer slicer = Slicer::load(std::move(parsed_program), mode_options, &mem_report);
+        Vertices const& vertices = slicer.vertices();
+        storm::prism::Program const& program = slicer.program();
 
+        // crit must be the code snippet of some vertex\in vertices OR Variable OR Module
+        if(mode=="v" || mode=="variable" || mode=="var" || mode=="c" || mode=="component" || mode=="l"
+           || mode=="label" || mode=="r" || mode=="reward"){
+            // single backward slice
+            SliceResult slice = slicer.slice(mode, std::vector<std::string>(argv + 3, argv + argc));
+            mem_report.phase("slicing");
+            if(emit){
+                write_prism_from_vertices(slice.components, program);
+            }
+            std::cout << "fingerprint: " << format_fingerprint(slice.fingerprint()) << std::endl;
+            if(build){
+                PRISL_TRACE_BEGIN(build_span, "build", "model build");
+                std::shared_ptr<storm::models::sparse::Model<double>> model = storm::api::buildSparseModel<double>(slice.to_program(), {});
+                PRISL_TRACE_END(build_span);
+                mem_report.phase("model build");
+                std::cout << "slice model: " << model->getNumberOfStates() << " states, " << model->getNumberOfTransitions() << " transitions" << std::endl;
+            }
+
+        } else if((mode=="f" || mode=="forward") && argc > 4){
+            SliceResult slice = slicer.slice_forward(slicer.criteria(argv[3], std::vector<std::string>(argv + 4, argv + argc)));
+            mem_report.phase("slicing");
+            write_prism_from_vertices(slice.components, program);
+            std::cout << "fingerprint: " << format_fingerprint(slice.fingerprint()) << std::endl;
+
+        } else if(mode=="chop" && argc > 4){
+            // chop TYPE SOURCES... -- TARGETS...
+            char **separator = std::find(argv + 4, argv + argc, std::string("--"));
+            if(separator == argv + argc){
+                throw std::invalid_argument( "expected '--' between the sources and the targets of the chop" );
+            }
+            std::vector<int> sources = slicer.criteria(argv[3], std::vector<std::string>(argv + 4, separator));
+            std::vector<int> targets = slicer.criteria(argv[3], std::vector<std::string>(separator + 1, argv + argc));
+
+            SliceResult chop = slicer.chop(sources, targets);
+            mem_report.phase("slicing");
+            write_prism_from_vertices(chop.components, program);
+            std::cout << "fingerprint: " << format_fingerprint(chop.fingerprint()) << std::endl;
+
+        } else if(mode=="sweep" && argc > 5){
+            // sweep VALUATIONS TYPE CRIT..., one constant valuation per line of the file VALUATIONS
+            std::ifstream valuation_file(argv[3]);
+            if(!valuation_file.is_open()){
+                throw std::invalid_argument( "Unable to open valuation file" );
+            }
+            std::vector<std::string> valuations;
+            std::string line;
+            while(std::getline(valuation_file, line)){
+                if(!line.empty()){ valuations.push_back(line);}
+            }
+            std::vector<int> crits = slicer.criteria(argv[4], std::vector<std::string>(argv + 5, argv + argc));
+
+            // the graph of the parametric program is built once for the whole sweep
+            for(int k = 0; k < valuations.size(); k++){
+                // constants given with -const are already part of the program
+                std::unordered_set<uint_fast64_t> blocked;
+                std::vector<bool> live = live_vertices(vertices, program, valuations.at(k), &blocked);
+                SliceResult slice = slicer.slice(crits, &live);
+                block_commands(slice.components, blocked, program);
+                std::string path = "slice_" + std::to_string(k) + ".prism";
+                write_prism_from_vertices(slice.components, program, path);
+                std::cout << valuations.at(k) << " -> " << path << " (" << slice.size() << "/" << vertices.size() << " components, fingerprint "
+                          << format_fingerprint(slice.fingerprint()) << ")" << std::endl;
+            }
+            mem_report.phase("slicing");
+
+        } else if(mode=="deps"){
+            // deps MASK..., benchmarks the component slices for every mask of dependence kinds on one graph
+            std::vector<EdgeKinds> masks;
             for(int i = 3; i < argc; i++){
-                bool found = false;
-                for(int index = 0; index < vertices.size(); index++){
-                    //if node.type contains string decl
-                    if(vertices.at(index).type.find("decl") != std::string::npos){ 
-                        for(storm::expressions::Variable var : vertices.at(index).def){
-                            if(var.getName() == argv[i]){
-                                crits.push_back(vertices.at(index).code_segment);
-                                found = true;
-                                break;
-                            }
-                        }
-                    }
-                    if(found) {break;}
-                }
-                legal_crit = legal_crit && found;
+                masks.push_back(parse_dependence_kinds(argv[i]));
             }
 
-            if(legal_crit){
-                std::vector<std::vector<int>> adj_list = build_comp_adj_list(vertices, program);
-                std::vector<BetterNode> sliced_cdg = slice_cdg_by_comp(vertices, adj_list, crits, program);
-                write_prism_from_vertices(sliced_cdg, program);
-            } else {
-                throw std::invalid_argument( "given variable criterion is not in given program" );
+            const char* kind_names[] = {"ar", "gg", "ag", "data", "di", "ra"};
+            std::cout << "edges by kind:";
+            for(int bit = 0; bit < 6; bit++){
+                int count = 0;
+                for(std::vector<EdgeKinds> const& kinds_vector : slicer.edge_kinds()){
+                    count += std::count_if(kinds_vector.begin(), kinds_vector.end(), [bit](EdgeKinds kinds){ return kinds & (1 << bit);});
+                }
+                std::cout << " " << kind_names[bit] << "=" << count;
             }
+            std::cout << std::endl;
 
-        } else if(mode =="c" || mode=="component") {
+            for(int k = 0; k < masks.size(); k++){
+                slicer.select_dependences(masks.at(k));
+                auto start = std::chrono::high_resolution_clock::now();
+                Result res = benchmark(slicer, false);
+                double slicing_in_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+                std::cout << argv[3 + k] << ": " << res.edges << " edges, " << res.slices << " slices, avg_size unweighted "
+                          << res.avg_size_uw << ", weighted " << res.avg_size_w << ", slicing took " << slicing_in_seconds << " seconds" << std::endl;
+            }
+            mem_report.phase("slicing");
+            mem_report.add("dependences", adj_list_bytes(slicer.dependences()));
 
-            std::vector<std::string> crits;
+        } else if(mode=="p" || mode=="property" || mode=="properties"){
+            // argv[3] is a properties file or a formula string, both are understood by the storm property parser
+            std::vector<storm::jani::Property> properties = storm::api::parsePropertiesForPrismProgram(argv[3], program);
+            if(properties.empty()){
+                throw std::invalid_argument( "no property found in given properties" );
+            }
 
-            bool legal_crit = true;
-            for(int i = 3; i < argc; i++){
-                bool found = false;
-                for(int index = 0;index < vertices.size(); index++){
-                    if(vertices.at(index).code_segment == argv[i]){
-                        crits.push_back(argv[i]);
-                        found = true;
+            if(joint){
+                // one slice for all properties together
+                std::vector<int> crits;
+                for(storm::jani::Property const& property : properties){
+                    std::vector<int> property_crits = slicer.criteria(property);
+                    crits.insert(crits.end(), property_crits.begin(), property_crits.end());
+                }
+                SliceResult slice = slicer.slice(crits);
+                if(emit){
+                    write_prism_from_vertices(slice.components, program);
+                }
+                std::cout << "fingerprint: " << format_fingerprint(slice.fingerprint()) << std::endl;
+                if(build){
+                    check_slice(slice.to_program(), properties);
+                }
+            } else {
+                // one slice per property
+                for(int k = 0; k < properties.size(); k++){
+                    SliceResult slice = slicer.slice(slicer.criteria(properties.at(k)));
+                    std::string path = "slice_" + std::to_string(k) + ".prism";
+                    if(emit){
+                        write_prism_from_vertices(slice.components, program, path);
+                    }
+                    std::cout << properties.at(k).getName() << ": " << properties.at(k).getRawFormula()->toString()
+                        << " -> " << (emit ? path : std::string("memory")) << " (" << slice.size() << "/" << vertices.size() << " components, fingerprint "
+                        << format_fingerprint(slice.fingerprint()) << ")" << std::endl;
+                    if(build){
+                        check_slice(slice.to_program(), {properties.at(k)});
                     }
                 }
-                legal_crit = legal_crit && found;
             }
+            mem_report.phase("slicing");
 
-            if(legal_crit){
-                std::vector<std::vector<int>> adj_list = build_comp_adj_list(vertices, program);
-                std::vector<BetterNode> sliced_cdg = slice_cdg_by_comp(vertices, adj_list, crits, program);
-                write_prism_from_vertices(sliced_cdg, program);
-            } else {
-                throw std::invalid_argument( "There was atleast 1 component we couldnt find" );
+        } else if(mode=="plan"){
+            // plan PROPERTIES, as few sliced models as possible for all properties and a manifest of what to check on each
+            std::vector<storm::jani::Property> properties = storm::api::parsePropertiesForPrismProgram(argv[3], program);
+            if(properties.empty()){
+                throw std::invalid_argument( "no property found in given properties" );
             }
-        } else if(mode=="m" || mode=="module"){
-            std::vector<std::string> crits = {};
-            bool legal_crit = true;
 
-            std::vector<Module_node> module_vertices = get_module_nodes(program);
-            for(int i = 3; i < argc; i++){
-                bool found = false;
-                for(Module_node mod : module_vertices){
-                    if(mod.module_name == argv[i]){
-                        crits.push_back(argv[i]);
-                        found = true;
-                        break;
-                    }
-                }
-                legal_crit = legal_crit && found;
+            std::vector<std::vector<bool>> slices;
+            for(storm::jani::Property const& property : properties){
+                slices.push_back(slicer.slice(slicer.criteria(property)).visited);
             }
-            
-            if(legal_crit){
-                std::vector<std::vector<int>> adj_list = create_adj_list(module_vertices);
-                std::vector<Module_node> slice = slice_mdg(adj_list, module_vertices, crits);
-                std::vector<BetterNode> cdg_slice={};
+            std::vector<PlannedSlice> plan = plan_slices(slices, merge_budget);
 
-                for(Module_node module : slice){
-                    for(BetterNode comp : vertices){
-                        if(module.module_name == comp.module_name){
-                            cdg_slice.push_back(comp);
-                        }
-                    }
+            std::ofstream manifest("manifest.txt");
+            if(!manifest.is_open()){
+                throw std::invalid_argument( "Unable to open manifest.txt" );
+            }
+            for(int k = 0; k < plan.size(); k++){
+                SliceResult slice = slicer.collect(plan.at(k).visited);
+                std::string path = "slice_" + std::to_string(k) + ".prism";
+                if(emit){
+                    write_prism_from_vertices(slice.components, program, path);
+                }
+                std::cout << path << " (" << slice.size() << "/" << vertices.size() << " components):";
+                std::vector<storm::jani::Property> model_properties;
+                for(int member : plan.at(k).members){
+                    // one line per property: model, property name, formula
+                    manifest << path << " " << properties.at(member).getName() << " " << properties.at(member).getRawFormula()->toString() << "\n";
+                    std::cout << " " << properties.at(member).getName();
+                    model_properties.push_back(properties.at(member));
+                }
+                std::cout << std::endl;
+                if(build){
+                    check_slice(slice.to_program(), model_properties);
                 }
-                write_prism_from_vertices(cdg_slice, program);
-            } else {
-                throw std::invalid_argument( "given modulename is not in given program" );
             }
+            std::cout << properties.size() << " properties on " << plan.size() << " models, manifest written to manifest.txt" << std::endl;
+            mem_report.phase("slicing");
+
+        } else if(mode=="m" || mode=="module"){
+            // the quotient of the component graph, so synchronization follows the system block, -deps and --smt
+            SliceResult slice = slicer.slice_modules(std::vector<std::string>(argv + 3, argv + argc));
+            mem_report.phase("slicing");
+            write_prism_from_vertices(slice.components, program);
+            mem_report.add("mdg_adj_list", adj_list_bytes(slicer.module_adj_list()));
+
         } else {
-            std::cout << "expected either v|c|m; but got: " << argv[2] <<std::endl;
+            std::cout << "expected either v|c|l|r|m|f|chop|sweep|p|plan|deps; but got: " << argv[2] <<std::endl;
             throw std::invalid_argument( "Wrong combination of argumentcount and arguments" );
         }
-
+        add_slicer_memory(mem_report, slicer);
 
     } else {
         throw std::invalid_argument( "wrong amount of arguments" );
     }
+
+    mem_report.print();
+    mem_report.write_json();
+    Tracer::instance().write(trace_path);
 }
@@ -0,0 +1,202 @@
+#include "mdg.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <map>
+
+std::vector<Module_node> slice_mdg( std::vector<std::vector<int>> adj_list, 
+                                    std::vector<Module_node> module_nodes, 
+                                    std::vector<std::string> crits){
+//return subseteq of module_nodes containing only the module_nodes relevant for module with name crit
+    std::vector<Module_node> slice={};
+    int nr_modules = module_nodes.size();
+
+    std::vector<int> starting_indices={};
+    for(std::string crit : crits){
+        bool found;
+        for(int index = 0; index < module_nodes.size();index++){
+            if(module_nodes.at(index).module_name == crit){
+                starting_indices.push_back(index);
+                break;
+            }
+        }
+    }
+
+    bool *visited = new bool[nr_modules];
+    for(int i = 0; i < nr_modules; i++){
+        visited[i] = false;
+    }
+    std::list<int> queue;
+ 
+    for(int s : starting_indices){
+        visited[s] = true;
+        //push all criteria
+        queue.push_back(s);
+    }
+    // 'i' will be used to get all adjacent
+    // vertices of a vertex
+    std::vector<int>::iterator i;
+
+    
+    while(!queue.empty())
+    {
+        int s;
+        s = queue.front();
+        queue.pop_front();
+ 
+        for (i = adj_list[s].begin(); i != adj_list[s].end(); ++i)
+        {
+            if (!visited[*i])
+            {
+                visited[*i] = true;
+                queue.push_back(*i);
+            }
+        }
+    }
+
+
+    for(int j=0; j < nr_modules; j++){
+        if(visited[j]){
+            slice.push_back(module_nodes[j]);
+        }
+    }
+
+    return slice;
+}
+
+std::vector<bool> slice_mdg_benchmark(std::vector<std::vector<int>> adj_list, 
+                                        std::vector<Module_node> vertices, 
+                                        std::string crit){
+//return subseteq of module_nodes containing only the module_nodes relevant for module with name crit
+    int nr_modules = vertices.size();
+
+    int starting_index = 0;
+    for(; starting_index < nr_modules; starting_index++){
+        if(vertices.at(starting_index).module_name == crit){
+            break;
+        }
+    }
+
+    std::vector<bool> visited = {};
+    for(int i = 0; i < nr_modules; i++){
+        visited.push_back(false);
+    }
+
+    std::list<int> queue;
+ 
+    visited.at(starting_index) = true;
+    queue.push_back(starting_index);
+
+    // 'i' will be used to get all adjacent
+    // vertices of a vertex
+    std::vector<int>::iterator i;
+
+    
+    while(!queue.empty())
+    {
+        int s;
+        s = queue.front();
+        queue.pop_front();
+ 
+        for (i = adj_list[s].begin(); i != adj_list[s].end(); ++i)
+        {
+            if (!visited.at(*i))
+            {
+                visited.at(*i) = true;
+                queue.push_back(*i);
+            }
+        }
+    }
+
+    return visited;
+}
+
+void mdg_benchmark(std::vector<Module_node> const& vertices,
+                   std::vector<std::vector<int>> const& adj_list,
+                   storm::prism::Program const& program){
+
+    std::cout << "\n\nStarting MODULE Benchmark\n\n";
+
+    int nr_nodes = vertices.size();
+    int nr_edges = 0;
+    for(std::vector<int> adj_vector : adj_list){
+        nr_edges += adj_vector.size();
+    }
+    int nr_slices = 0;
+
+    //vector of slice sizes to calculate avg slice size
+    int slice_sizes;
+
+    std::map<int, std::vector<std::vector<bool>>> size_by_slices;
+    std::map<int, int> size_by_crits;
+
+
+    for(int index = 0; index < vertices.size(); index++ ){
+        std::string crit;
+        crit = vertices.at(index).module_name;
+        std::vector<bool> visited = slice_mdg_benchmark(adj_list, vertices, crit);
+        int slice_size = std::count(visited.begin(), visited.end(), true);
+        std::map<int, std::vector<std::vector<bool>>>::iterator map_it = size_by_slices.find(slice_size);
+        if(map_it != size_by_slices.end()){
+            size_by_crits[map_it->first] += 1;
+            bool found = false;
+            std::vector<std::vector<bool>> visits_with_same_size = size_by_slices[map_it->first];
+            for(std::vector<bool> visits : visits_with_same_size){
+                bool equal=true;
+                for(int comp = 0; comp < visits.size(); comp++){
+                    if(visits.at(comp) != visited.at(comp)){
+                        equal = false;
+                        break;
+                    }
+                }
+                if(equal){
+                    found=true;
+                    break;
+                }
+            }
+            if(!found){
+                size_by_slices[map_it->first].push_back(visited);
+            }
+        } else {
+            std::vector<std::vector<bool>> new_visits;
+            new_visits.push_back(visited);
+            size_by_slices.insert(std::make_pair(slice_size, new_visits));
+            std::cout<< "new length " << slice_size << " for slice of module: " << vertices.at(index).module_name << std::endl;
+
+            size_by_crits.insert(std::make_pair(slice_size, 1));
+        }
+    }
+
+    int amount_unique_slices = 0;
+    int avg_slice_size = 0;
+    float size_by_unique_sum = 0;
+    float size_by_crits_sum = 0;
+    std::cout<< std::endl;
+    for(std::pair<int, std::vector<std::vector<bool>>> x : size_by_slices) {
+        size_by_unique_sum += x.first * x.second.size();
+        size_by_crits_sum += x.first * size_by_crits[x.first];
+        amount_unique_slices += x.second.size();
+        avg_slice_size += (x.first * x.second.size());
+        std::cout << "got " << x.second.size() << " unique slices with length: " << x.first;
+        std::cout << " produced by " << size_by_crits[x.first] << "/" << vertices.size() << " = " <<static_cast<float>(size_by_crits[x.first])/static_cast<float>(vertices.size()) << " percent of all components" << std::endl;
+    }
+    
+
+    std::cout << "Results: \n";
+    std::cout << "      modules: " << nr_nodes << std::endl;
+    std::cout << "      edges: " << nr_edges << std::endl;
+    std::cout << "      slices: " << amount_unique_slices << std::endl;
+    std::cout << "      avg_size_uw = " << size_by_unique_sum << "/" << static_cast<float>(amount_unique_slices)<< " = " <<  
+        size_by_unique_sum / static_cast<float>(amount_unique_slices) << std::endl;
+    std::cout << "      avg_size_w = " << size_by_crits_sum  << "/" <<  static_cast<float>(vertices.size()) << " = " <<
+        size_by_crits_sum / static_cast<float>(vertices.size()) << std::endl;
+
+
+    
+    // print and test 
+    // res.print();
+
+}
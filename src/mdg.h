@@ -0,0 +1,37 @@
+#pragma once
+
+// module dependence graph (MDG): modules as vertices, sliced by module
+
+#include <storm/storage/prism/Program.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+typedef storm::expressions::Variable Variable;
+
+struct Module_node {
+    std::string module_name;
+    std::set<storm::expressions::Variable> def; //Names of the defined variables
+    std::set<storm::expressions::Variable> ref; //Names of the referenced/declared variables
+    std::set<std::string> act; //Names of the used actions inside module
+
+    void reset_node(){
+        this->module_name.clear();
+        this->def.clear();
+        this->ref.clear();
+        this->act.clear();
+    }
+};
+
+std::vector<Module_node> slice_mdg( std::vector<std::vector<int>> adj_list, 
+                                    std::vector<Module_node> module_nodes, 
+                                    std::vector<std::string> crits);
+
+std::vector<bool> slice_mdg_benchmark(std::vector<std::vector<int>> adj_list, 
+                                        std::vector<Module_node> vertices, 
+                                        std::string crit);
+
+void mdg_benchmark(std::vector<Module_node> const& vertices,
+                   std::vector<std::vector<int>> const& adj_list,
+                   storm::prism::Program const& program);
@@ -0,0 +1,91 @@
+#include "memory.h"
+
+#include <sys/resource.h> // getrusage for peak RSS
+
+size_t peak_rss_bytes(){
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<size_t>(usage.ru_maxrss) * 1024; // linux reports kilobytes
+}
+
+size_t expression_bytes(storm::expressions::Expression const& expr){
+    if(!expr.isInitialized()){
+        return 0;
+    }
+    size_t bytes = sizeof(storm::expressions::BaseExpression) + 2 * sizeof(long); // node and its shared_ptr control block
+    for(uint_fast64_t i = 0; i < expr.getArity(); i++){
+        bytes += sizeof(std::shared_ptr<storm::expressions::BaseExpression const>) + expression_bytes(expr.getOperand(i));
+    }
+    return bytes;
+}
+
+size_t program_bytes(storm::prism::Program const& program){
+    size_t bytes = sizeof(storm::prism::Program);
+    for(auto const& boolvar : program.getGlobalBooleanVariables()){
+        bytes += sizeof(boolvar) + string_heap_bytes(boolvar.getName());
+        if(boolvar.hasInitialValue()){ bytes += expression_bytes(boolvar.getInitialValueExpression());}
+    }
+    for(auto const& intvar : program.getGlobalIntegerVariables()){
+        bytes += sizeof(intvar) + string_heap_bytes(intvar.getName()) + expression_bytes(intvar.getRangeExpression());
+        if(intvar.hasInitialValue()){ bytes += expression_bytes(intvar.getInitialValueExpression());}
+    }
+    for(auto const& constant : program.getConstants()){
+        bytes += sizeof(constant) + string_heap_bytes(constant.getName());
+        if(constant.isDefined()){ bytes += expression_bytes(constant.getExpression());}
+    }
+    for(auto const& formula : program.getFormulas()){
+        bytes += sizeof(formula) + string_heap_bytes(formula.getName()) + expression_bytes(formula.getExpression());
+    }
+    for(auto const& module : program.getModules()){
+        bytes += sizeof(module) + string_heap_bytes(module.getName());
+        for(auto const& boolvar : module.getBooleanVariables()){
+            bytes += sizeof(boolvar) + string_heap_bytes(boolvar.getName());
+            if(boolvar.hasInitialValue()){ bytes += expression_bytes(boolvar.getInitialValueExpression());}
+        }
+        for(auto const& intvar : module.getIntegerVariables()){
+            bytes += sizeof(intvar) + string_heap_bytes(intvar.getName()) + expression_bytes(intvar.getRangeExpression());
+            if(intvar.hasInitialValue()){ bytes += expression_bytes(intvar.getInitialValueExpression());}
+        }
+        for(auto const& c : module.getCommands()){
+            bytes += sizeof(c) + string_heap_bytes(c.getActionName()) + expression_bytes(c.getGuardExpression());
+            for(auto const& u : c.getUpdates()){
+                bytes += sizeof(u) + expression_bytes(u.getLikelihoodExpression());
+                for(auto const& a : u.getAssignments()){
+                    bytes += sizeof(a) + expression_bytes(a.getExpression());
+                }
+            }
+        }
+    }
+    if(program.hasInitialConstruct()){
+        bytes += expression_bytes(program.getInitialStatesExpression());
+    }
+    return bytes;
+}
+
+size_t vertex_string_bytes(BetterNode const& node){
+    return string_heap_bytes(node.type) + string_heap_bytes(node.module_name) + string_heap_bytes(node.rendered_code)
+        + string_heap_bytes(node.name) + string_heap_bytes(node.action);
+}
+
+size_t vertex_set_bytes(BetterNode const& node){
+    return (node.ref.size() + node.def.size()) * (sizeof(storm::expressions::Variable) + 4 * sizeof(void*));
+}
+
+size_t adj_list_bytes(std::vector<std::vector<int>> const& adj_list){
+    size_t bytes = adj_list.capacity() * sizeof(std::vector<int>);
+    for(std::vector<int> const& adj_vector : adj_list){
+        bytes += adj_vector.capacity() * sizeof(int);
+    }
+    return bytes;
+}
+
+size_t slice_store_bytes(std::map<int, std::vector<std::vector<bool>>> const& size_by_slices){
+    size_t bytes = 0;
+    for(auto const& x : size_by_slices){
+        bytes += sizeof(x) + 4 * sizeof(void*) + x.second.capacity() * sizeof(std::vector<bool>);
+        for(std::vector<bool> const& visits : x.second){
+            bytes += (visits.capacity() + 7) / 8;
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+// bytes held by the pipeline structures and the peak RSS per phase (--mem, --mem-json)
+
+#include "graph.h"
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+// forwards to an upstream resource and counts the bytes currently held from it,
+// used below the vertex arena to see how much the arena really reserved
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : upstream(upstream) {}
+
+    size_t bytes() const { return held; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        held += bytes;
+        return upstream->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        held -= bytes;
+        upstream->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream;
+    size_t held = 0;
+};
+
+// peak resident set size of the process so far
+size_t peak_rss_bytes();
+
+// heap bytes of a string, nothing if it fits in the small string buffer
+template<typename String>
+size_t string_heap_bytes(String const& str){
+    return str.capacity() > String().capacity() ? str.capacity() + 1 : 0;
+}
+
+// estimate of an expression tree, shared subexpressions are counted once per reference
+size_t expression_bytes(storm::expressions::Expression const& expr);
+
+// estimate of the bytes held by the parsed program (declarations, commands and their expressions)
+size_t program_bytes(storm::prism::Program const& program);
+
+size_t vertex_string_bytes(BetterNode const& node);
+
+// a set node holds the variable and the red black tree header (color, parent, left, right)
+size_t vertex_set_bytes(BetterNode const& node);
+
+size_t adj_list_bytes(std::vector<std::vector<int>> const& adj_list);
+
+// unique slices of a benchmark, stored by slice size
+size_t slice_store_bytes(std::map<int, std::vector<std::vector<bool>>> const& size_by_slices);
+
+// bytes held by the pipeline structures and the peak RSS after each phase, enabled by --mem or --mem-json FILE
+struct MemoryReport {
+    bool enabled = false;
+    std::string json_path;
+    std::vector<std::pair<std::string, size_t>> structures;
+    std::vector<std::pair<std::string, size_t>> peak_rss;
+
+    void add(std::string const& name, size_t bytes){
+        if(enabled){
+            structures.emplace_back(name, bytes);
+        }
+    }
+
+    void phase(std::string const& name){
+        if(enabled){
+            peak_rss.emplace_back(name, peak_rss_bytes());
+        }
+    }
+
+    void add_vertices(Vertices const& vertices, CountingResource const& arena_upstream){
+        if(!enabled){ return;}
+        size_t strings = 0;
+        size_t sets = 0;
+        for(BetterNode const& node : vertices){
+            strings += vertex_string_bytes(node);
+            sets += vertex_set_bytes(node);
+        }
+        add("vertices.metadata", vertices.capacity() * sizeof(BetterNode));
+        add("vertices.strings", strings);
+        add("vertices.ref_def_sets", sets);
+        add("vertices.arena_reserved", arena_upstream.bytes());
+    }
+
+    void print(){
+        if(!enabled){ return;}
+        std::cout << "Memory (bytes):\n";
+        for(auto const& entry : structures){
+            std::cout << "      " << entry.first << ": " << entry.second << "\n";
+        }
+        std::cout << "Peak RSS (bytes):\n";
+        for(auto const& entry : peak_rss){
+            std::cout << "      after " << entry.first << ": " << entry.second << "\n";
+        }
+    }
+
+    void write_json(){
+        if(!enabled || json_path.empty()){ return;}
+        std::ofstream jsonfile(json_path);
+        if(!jsonfile.is_open()){
+            std::cout << "Unable to open file" <<std::endl;
+            return;
+        }
+        jsonfile << "{\n  \"structures\": {";
+        for(int i = 0; i < structures.size(); i++){
+            jsonfile << (i == 0 ? "\n" : ",\n") << "    \"" << structures.at(i).first << "\": " << structures.at(i).second;
+        }
+        jsonfile << "\n  },\n  \"peak_rss\": {";
+        for(int i = 0; i < peak_rss.size(); i++){
+            jsonfile << (i == 0 ? "\n" : ",\n") << "    \"" << peak_rss.at(i).first << "\": " << peak_rss.at(i).second;
+        }
+        jsonfile << "\n  }\n}\n";
+    }
+};
@@ -0,0 +1,96 @@
+#include "pipeline.h"
+#include "benchmark.h"
+#include "trace.h"
+
+#include <storm-parsers/parser/PrismParser.h>
+
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+// a model between two stages
+struct ParsedModel {
+    std::filesystem::path path;
+    std::unique_ptr<storm::prism::Program> program; // null if parsing failed
+    std::string error;
+};
+
+struct SlicedModel {
+    std::filesystem::path path;
+    std::unique_ptr<Slicer> slicer; // owns the program and vertices the slice refers to
+    SliceResult slice;
+    std::string error;
+};
+
+int run_batch(std::string const& dir,
+              std::string const& type,
+              std::vector<std::string> const& crits,
+              std::string const& constants,
+              Slicer::Options const& options,
+              size_t queue_capacity){
+    std::vector<std::filesystem::path> models = model_files(dir);
+    BoundedQueue<ParsedModel> parsed(queue_capacity);
+    BoundedQueue<SlicedModel> sliced(queue_capacity);
+
+    std::thread parse_stage([&](){
+        for(std::filesystem::path const& path : models){
+            ParsedModel item;
+            item.path = path;
+            try {
+                PRISL_TRACE_SCOPE("parse", "parse", path.filename().string());
+                storm::prism::Program program = storm::parser::PrismParser::parse(path.string(), true);
+                if(!constants.empty()){
+                    program = instantiate_constants(program, constants);
+                }
+                item.program = std::make_unique<storm::prism::Program>(std::move(program));
+            } catch(std::exception const& e){
+                item.error = e.what();
+            }
+            parsed.push(std::move(item));
+        }
+        parsed.close();
+    });
+
+    std::thread slice_stage([&](){
+        ParsedModel item;
+        while(parsed.pop(item)){
+            SlicedModel out;
+            out.path = item.path;
+            out.error = item.error;
+            if(item.program){
+                try {
+                    out.slicer = std::make_unique<Slicer>(Slicer::load(std::move(*item.program), options));
+                    out.slice = out.slicer->slice(type, crits);
+                } catch(std::exception const& e){
+                    out.error = e.what();
+                    out.slicer.reset();
+                }
+            }
+            item.program.reset();
+            sliced.push(std::move(out));
+        }
+        sliced.close();
+    });
+
+    // writing is the last stage, on the calling thread
+    int failures = 0;
+    SlicedModel item;
+    while(sliced.pop(item)){
+        if(!item.error.empty()){
+            std::cout << item.path.filename().string() << ": " << item.error << std::endl;
+            failures += 1;
+            continue;
+        }
+        std::string path = item.path.stem().string() + "_slice.prism";
+        write_prism_from_vertices(item.slice.components, item.slicer->program(), path);
+        std::cout << item.path.filename().string() << " -> " << path << " (" << item.slice.size() << "/"
+                  << item.slicer->vertices().size() << " components, fingerprint " << format_fingerprint(item.slice.fingerprint())
+                  << ")" << std::endl;
+        item.slicer.reset(); // the model is done, do not keep it until the next one arrives
+    }
+    parse_stage.join();
+    slice_stage.join();
+    return failures;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// slicing a directory of models with overlapping stages: while one model is sliced the next one is parsed and the
+// slice of the previous one is written (batch)
+
+#include "slicer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// queue between two pipeline stages, push blocks while it is full so a fast stage cannot run ahead of a slow one
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    void push(T item){
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this]{ return items.size() < capacity;});
+        items.push_back(std::move(item));
+        not_empty.notify_one();
+    }
+
+    // blocks while the queue is empty, false once it is closed and drained
+    bool pop(T &item){
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this]{ return !items.empty() || closed;});
+        if(items.empty()){ return false;}
+        item = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    // no more pushes, pop returns false after the last item
+    void close(){
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        not_empty.notify_all();
+    }
+
+private:
+    size_t capacity;
+    bool closed = false;
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+};
+
+// slices every model of dir (see model_files) for the criteria and writes the slice of model.prism to
+// model_slice.prism. Parsing, slicing and writing run in three threads with queue_capacity models between each of
+// them. Models that fail to parse or lack a criterion are reported and skipped, their number is returned
+int run_batch(std::string const& dir,
+              std::string const& type,
+              std::vector<std::string> const& crits,
+              std::string const& constants,
+              Slicer::Options const& options,
+              size_t queue_capacity = 2);
@@ -0,0 +1,1180 @@
+#include "slicer.h"
+#include "trace.h"
+
+#include <storm/utility/cli.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+void check_slice_for_useless_commands(Vertices &vertices, storm::prism::Program const& program){ //checks if something can be sliced away after slicing
+    PRISL_TRACE_SCOPE("slice", "reduction");
+    for(storm::prism::Module module : program.getModules()){
+            bool module_relevant = false;
+            //check if this module is in vertices:
+            for(auto const& node : vertices){
+                if(std::string_view(node.module_name) == module.getName()){
+                    module_relevant=true;
+                    break;
+                }
+            }
+            if(!module_relevant) { continue;}
+
+        for(storm::prism::Command c : module.getCommands()){
+                // is command in slice and guard true?
+                bool relevant_guard_is_true = false; //relevant if guard is inside nodes
+                Vertices::iterator nodeptr;
+                for(nodeptr = vertices.begin(); nodeptr < vertices.end(); nodeptr++){
+                    if( (nodeptr->type == "guard") && c.getGuardExpression().isTrue() && (nodeptr->identifier == c.getGlobalIndex()) ){
+                        relevant_guard_is_true = true;
+                        break;
+                    }
+                }
+                if(!relevant_guard_is_true) {continue;}
+
+                //if no updates and guard.getExpression.isTrue
+                int update_counter=0;
+                for(storm::prism::Update u : c.getUpdates()){
+                    for(auto const& ratenode : vertices){
+                        if( (ratenode.identifier==u.getGlobalIndex()) && (ratenode.type=="rate") ){
+                            update_counter+=1;
+                        }
+                    }
+                }
+
+                if(update_counter==0){
+                    vertices.erase(nodeptr);
+                    continue;
+                }
+        }
+    }
+}
+
+std::vector<bool> reach_from(std::vector<std::vector<int>> const& adj_list,
+                             std::vector<int> const& starting_indices,
+                             std::vector<bool> const* within){
+    PRISL_TRACE_SCOPE("slice", "slice query");
+    std::vector<bool> visited(adj_list.size(), false);
+    std::list<int> queue;
+ 
+    for(int s : starting_indices){
+        if(within != nullptr && !within->at(s)){ continue;}
+        visited[s] = true;
+        //push all criteria
+        queue.push_back(s);
+    }
+    std::vector<int>::const_iterator i;
+    int s;
+    while(!queue.empty())
+    {
+        s = queue.front();
+        queue.pop_front();
+ 
+        for (i = adj_list[s].begin(); i != adj_list[s].end(); ++i)
+        {
+            if (!visited[*i] && (within == nullptr || (*within)[*i]))
+            {
+                visited[*i] = true;
+                queue.push_back(*i);
+            }
+        }
+    }
+    return visited;
+}
+
+std::vector<std::vector<int>> transpose_adj_list(std::vector<std::vector<int>> const& adj_list){
+    std::vector<std::vector<int>> transposed(adj_list.size());
+    for(int i = 0; i < adj_list.size(); i++){
+        for(int j : adj_list[i]){
+            transposed[j].push_back(i);
+        }
+    }
+    return transposed;
+}
+
+VertexOrder parse_vertex_order(std::string const& name){
+    if(name == "program"){ return VertexOrder::program;}
+    if(name == "bfs"){ return VertexOrder::bfs;}
+    if(name == "rcm"){ return VertexOrder::rcm;}
+    if(name == "degree"){ return VertexOrder::degree;}
+    throw std::invalid_argument( "unknown vertex order " + name + ", expected program|bfs|rcm|degree" );
+}
+
+std::vector<int> vertex_order(std::vector<std::vector<int>> const& adj_list, VertexOrder kind){
+    int n = adj_list.size();
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    if(kind == VertexOrder::program){ return order;}
+
+    // locality is about both directions, a search follows the edges and a forward slice the reversed ones
+    std::vector<std::vector<int>> undirected = transpose_adj_list(adj_list);
+    for(int i = 0; i < n; i++){
+        undirected[i].insert(undirected[i].end(), adj_list[i].begin(), adj_list[i].end());
+        std::sort(undirected[i].begin(), undirected[i].end());
+        undirected[i].erase(std::unique(undirected[i].begin(), undirected[i].end()), undirected[i].end());
+    }
+    auto by_degree = [&undirected](int a, int b){ return undirected[a].size() < undirected[b].size();};
+
+    if(kind == VertexOrder::degree){
+        std::stable_sort(order.begin(), order.end(), [&by_degree](int a, int b){ return by_degree(b, a);});
+        return order;
+    }
+
+    // bfs and rcm: one breadth first search per connected part, rcm starts at a least degree vertex and takes the
+    // neighbours by increasing degree
+    std::vector<int> roots = order;
+    if(kind == VertexOrder::rcm){
+        std::stable_sort(roots.begin(), roots.end(), by_degree);
+        for(std::vector<int> &neighbours : undirected){
+            std::stable_sort(neighbours.begin(), neighbours.end(), by_degree);
+        }
+    }
+    order.clear();
+    std::vector<bool> numbered(n, false);
+    for(int root : roots){
+        if(numbered[root]){ continue;}
+        numbered[root] = true;
+        size_t head = order.size();
+        order.push_back(root);
+        while(head < order.size()){
+            int v = order[head++];
+            for(int w : undirected[v]){
+                if(!numbered[w]){
+                    numbered[w] = true;
+                    order.push_back(w);
+                }
+            }
+        }
+    }
+    if(kind == VertexOrder::rcm){
+        std::reverse(order.begin(), order.end());
+    }
+    return order;
+}
+
+std::vector<std::vector<int>> permute_adj_list(std::vector<std::vector<int>> const& adj_list,
+                                               std::vector<int> const& order,
+                                               std::vector<int> &position){
+    position.assign(order.size(), 0);
+    for(int k = 0; k < order.size(); k++){
+        position[order[k]] = k;
+    }
+    std::vector<std::vector<int>> permuted(order.size());
+    for(int k = 0; k < order.size(); k++){
+        permuted[k].reserve(adj_list[order[k]].size());
+        for(int j : adj_list[order[k]]){
+            permuted[k].push_back(position[j]);
+        }
+        std::sort(permuted[k].begin(), permuted[k].end()); // the search reads the visited flags in ascending order
+    }
+    return permuted;
+}
+
+Vertices collect_slice(Vertices const& vertices, std::vector<bool> const& visited, storm::prism::Program const& program){
+    Vertices slice={};
+    for(int j=0; j < vertices.size(); j++){
+        if(visited[j]){
+            slice.push_back(vertices.at(j));
+        }
+    }
+
+    check_slice_for_useless_commands(slice,program);
+
+    return slice;
+}
+
+std::vector<bool> live_vertices(Vertices const& vertices, storm::prism::Program const& program, std::string const& definitions,
+                                std::unordered_set<uint_fast64_t>* blocked_commands){
+    std::map<Variable, storm::expressions::Expression> constant_definitions =
+        storm::utility::cli::parseConstantDefinitionString(program.getManager(), definitions);
+    storm::prism::Program defined = program.defineUndefinedConstants(constant_definitions).substituteConstants();
+
+    std::unordered_set<uint_fast64_t> dead_commands;
+    std::unordered_set<uint_fast64_t> dead_updates;
+    for(storm::prism::Module const& module : defined.getModules()){
+        for(storm::prism::Command const& c : module.getCommands()){
+            bool command_dead = c.getGuardExpression().simplify().isFalse();
+            int live_updates = 0;
+            for(storm::prism::Update const& u : c.getUpdates()){
+                storm::expressions::Expression rate = u.getLikelihoodExpression().simplify();
+                if(command_dead || (rate.isLiteral() && rate.evaluateAsDouble() == 0)){
+                    dead_updates.insert(u.getGlobalIndex());
+                } else {
+                    live_updates += 1;
+                }
+            }
+            if(command_dead || live_updates == 0){
+                dead_commands.insert(c.getGlobalIndex());
+            }
+        }
+    }
+
+    // the guards of these stay to keep the module blocking a. Their updates do not, so the guard has to be written as
+    // 'false' (block_commands), a live guard would give '[a] guard -> true;', a transition the program does not have
+    std::unordered_set<uint_fast64_t> alphabet = alphabet_commands(defined, dead_commands);
+    if(blocked_commands != nullptr){
+        *blocked_commands = alphabet;
+    }
+
+    std::vector<bool> live(vertices.size(), true);
+    for(int i = 0; i < vertices.size(); i++){
+        BetterNode const& node = vertices.at(i);
+        if(node.type == "guard"){
+            live[i] = dead_commands.count(node.identifier) == 0 || alphabet.count(node.identifier) > 0;
+        } else if(node.type == "rate" || node.type == "assignment"){
+            live[i] = dead_updates.count(node.identifier) == 0;
+        }
+    }
+    return live;
+}
+
+void block_commands(Vertices &slice, std::unordered_set<uint_fast64_t> const& commands, storm::prism::Program const& program){
+    for(BetterNode &node : slice){
+        if(node.type == "guard" && commands.count(node.identifier)){
+            node.replace_expr(program.getManager().boolean(false));
+        }
+    }
+}
+
+std::vector<bool> slice_cdg_benchmark(  Vertices const& vertices, 
+                                            std::vector<std::vector<int>> const& adj_list, 
+                                            std::vector<int> const& starting_indices,
+                                            storm::prism::Program const& program){
+    std::vector<bool> visited = reach_from(adj_list, starting_indices);
+
+    collect_slice(vertices, visited, program);
+
+    return visited;
+}
+
+// the index a criterion type looks its criteria up in: 'v', 'c', 'l' or 'r'. Throws for any other type
+char criterion_index(std::string const& type){
+    if(type=="v" || type=="variable" || type=="var"){
+        return 'v';
+    } else if(type =="c" || type=="component") {
+        return 'c';
+    } else if(type =="l" || type=="label") {
+        return 'l';
+    } else if(type =="r" || type=="reward") {
+        return 'r';
+    }
+    throw std::invalid_argument( "expected either v|c|l|r; but got: " + type );
+}
+
+std::vector<int> lookup_criteria(VertexIndex const& index, std::string const& type, std::vector<std::string> const& crits){
+    std::string error;
+    bool all_of_key = false; // a reward model is selected with all of its items
+    switch(criterion_index(type)){
+        case 'v': error = "given variable criterion is not in given program"; break;
+        case 'c': error = "There was atleast 1 component we couldnt find"; break;
+        case 'l': error = "given label criterion is not in given program"; break;
+        default:
+            error = "given reward model criterion is not in given program";
+            all_of_key = true;
+    }
+
+    std::vector<int> starting_indices={};
+    bool legal_crit = true;
+    for(std::string const& crit : crits){
+        VertexIndex::const_iterator it = index.find(crit);
+        bool found = it != index.end();
+        if(found && all_of_key){
+            starting_indices.insert(starting_indices.end(), it->second.begin(), it->second.end());
+        } else if(found){
+            starting_indices.push_back(it->second.front());
+        }
+        legal_crit = legal_crit && found;
+    }
+    if(!legal_crit){
+        throw std::invalid_argument( error );
+    }
+    return starting_indices;
+}
+
+std::vector<int> property_criteria(storm::jani::Property const& property,
+                                   VertexIndex const& variable_index,
+                                   VertexIndex const& label_index,
+                                   VertexIndex const& reward_index,
+                                   storm::prism::Program const& program){
+    std::set<int> crits;
+
+    for(storm::expressions::Variable const& var : property.getUsedVariablesAndConstants()){
+        VertexIndex::const_iterator it = variable_index.find(var.getName());
+        if(it != variable_index.end()){
+            crits.insert(it->second.front());
+        }
+    }
+
+    for(std::string const& label_name : property.getUsedLabels()){
+        VertexIndex::const_iterator it = label_index.find(label_name);
+        if(it != label_index.end()){
+            crits.insert(it->second.begin(), it->second.end());
+        }
+    }
+
+    for(std::string reward_name : property.getRawFormula()->getReferencedRewardModels()){
+        if(reward_name.empty() && program.getRewardModels().size() == 1){ // R=? refers to the only reward model
+            reward_name = program.getRewardModels().front().getName();
+        }
+        VertexIndex::const_iterator it = reward_index.find(reward_name);
+        if(it != reward_index.end()){
+            crits.insert(it->second.begin(), it->second.end());
+        }
+    }
+
+    return std::vector<int>(crits.begin(), crits.end());
+}
+
+// FNV-1a over the text, then the splitmix64 finalizer so that the sum of many hashes stays well mixed
+uint64_t hash_component(std::string const& text){
+    uint64_t hash = 14695981039346656037ull;
+    for(char c : text){
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebull;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+uint64_t slice_fingerprint(Vertices const& slice, storm::prism::Program const& program){
+    // the command context of every update: action and guard, and its rate
+    std::unordered_map<uint_fast64_t, std::string> command_context; // global command index ->
+    std::unordered_map<uint_fast64_t, std::string> update_context; // global update index ->
+    std::unordered_map<uint_fast64_t, storm::prism::Command const*> commands; // global command index ->
+    for(storm::prism::Module const& module : program.getModules()){
+        for(storm::prism::Command const& c : module.getCommands()){
+            std::string context = "[" + c.getActionName() + "]" + c.getGuardExpression().toString();
+            command_context[c.getGlobalIndex()] = context;
+            commands[c.getGlobalIndex()] = &c;
+            for(storm::prism::Update const& u : c.getUpdates()){
+                update_context[u.getGlobalIndex()] = context;
+            }
+        }
+    }
+    std::unordered_map<uint_fast64_t, std::string> rates; // global update index -> rate
+    for(BetterNode const& node : slice){
+        if(node.type == "rate"){
+            rates[node.identifier] = std::string(std::string_view(node.code_segment()));
+        }
+    }
+
+    // what the emitted program holds beside the components: the model type, the system block restricted to the
+    // modules of the slice, and (with the guards) the rates of the updates that are written as 'rate: true'
+    uint64_t fingerprint = hash_component("model" + std::string(1, '\0') + std::to_string(static_cast<int>(program.getModelType())));
+    if(program.specifiesSystemComposition()){
+        std::set<std::string> modules;
+        for(BetterNode const& node : slice){
+            if(!node.module_name.empty()){ modules.insert(std::string(node.module_name));}
+        }
+        std::shared_ptr<storm::prism::Composition> composition =
+            restrict_composition(program.getSystemCompositionConstruct().getSystemComposition(), modules);
+        if(composition){
+            std::ostringstream system;
+            system << *composition;
+            fingerprint += hash_component("system" + std::string(1, '\0') + system.str());
+        }
+    }
+
+    for(BetterNode const& node : slice){
+        std::string text(std::string_view(node.type));
+        text += '\0';
+        text += std::string_view(node.module_name);
+        text += '\0';
+        if(node.type == "guard"){
+            text += command_context[node.identifier];
+            // a command without updates in the slice is written as 'true', otherwise every update outside the slice
+            // keeps its rate
+            storm::prism::Command const& c = *commands.at(node.identifier);
+            bool has_updates = std::any_of(c.getUpdates().begin(), c.getUpdates().end(),
+                                           [&rates](storm::prism::Update const& u){ return rates.count(u.getGlobalIndex()) > 0;});
+            for(storm::prism::Update const& u : c.getUpdates()){
+                if(has_updates && rates.count(u.getGlobalIndex()) == 0){
+                    text += '\0';
+                    text += u.getLikelihoodExpression().toString();
+                }
+            }
+        } else if(node.type == "rate"){
+            text += update_context[node.identifier];
+        } else if(node.type == "assignment"){
+            text += update_context[node.identifier];
+            text += '\0';
+            text += rates[node.identifier];
+        } else if(node.type.compare(0, 6, "reward") == 0){
+            text += std::string_view(node.name); // the reward model
+        }
+        text += '\0';
+        for(char c : node.code_segment()){
+            if(!std::isspace(static_cast<unsigned char>(c))){ text += c;}
+        }
+        fingerprint += hash_component(text);
+    }
+    return fingerprint;
+}
+
+std::string format_fingerprint(uint64_t fingerprint){
+    char digits[17];
+    std::snprintf(digits, sizeof(digits), "%016llx", static_cast<unsigned long long>(fingerprint));
+    return digits;
+}
+
+std::vector<PlannedSlice> plan_slices(std::vector<std::vector<bool>> const& slices, double budget){
+    std::vector<size_t> sizes;
+    for(std::vector<bool> const& visited : slices){
+        sizes.push_back(std::count(visited.begin(), visited.end(), true));
+    }
+    std::vector<int> order(slices.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](int a, int b){ return sizes.at(a) > sizes.at(b);});
+
+    std::vector<PlannedSlice> plan;
+    for(int s : order){
+        std::vector<bool> const& visited = slices.at(s);
+        int best = -1; // model taking the slice
+        size_t best_growth = 0;
+        for(int m = 0; m < plan.size(); m++){
+            size_t added = 0; // vertices of the slice the model does not have yet
+            for(int i = 0; i < visited.size(); i++){
+                added += visited.at(i) && !plan.at(m).visited.at(i);
+            }
+            if(added == 0){ // contained, nothing better possible
+                best = m;
+                best_growth = 0;
+                break;
+            }
+            // near-equal: the union is at most budget larger than the larger of both
+            size_t larger = std::max(plan.at(m).size, sizes.at(s));
+            size_t growth = plan.at(m).size + added - larger;
+            if(growth <= budget * larger && (best == -1 || growth < best_growth)){
+                best = m;
+                best_growth = growth;
+            }
+        }
+        if(best == -1){
+            PlannedSlice planned;
+            planned.visited = visited;
+            planned.size = sizes.at(s);
+            planned.members.push_back(s);
+            plan.push_back(std::move(planned));
+            continue;
+        }
+        PlannedSlice &planned = plan.at(best);
+        for(int i = 0; i < visited.size(); i++){
+            if(visited.at(i) && !planned.visited.at(i)){
+                planned.visited.at(i) = true;
+                planned.size += 1;
+            }
+        }
+        planned.members.push_back(s);
+    }
+    for(PlannedSlice &planned : plan){
+        std::sort(planned.members.begin(), planned.members.end());
+    }
+    return plan;
+}
+
+void write_prism_from_vertices(Vertices const& vertices, storm::prism::Program const& program, std::ostream& prismfile){
+    PRISL_TRACE_SCOPE("emit", "emission");
+    //for globals
+    switch (program.getModelType())
+    {
+        case storm::prism::Program::ModelType::DTMC:
+            prismfile << "dtmc\n\n"; 
+            break;
+        case storm::prism::Program::ModelType::MDP:
+            prismfile << "mdp\n\n"; 
+            break;
+        case storm::prism::Program::ModelType::CTMC:
+            prismfile << "ctmc\n\n"; 
+            break;
+        case storm::prism::Program::ModelType::CTMDP :
+            prismfile << "ctmdp\n\n"; 
+            break;
+        case storm::prism::Program::ModelType::MA :
+            prismfile << "ma\n\n"; 
+            break;
+        case storm::prism::Program::ModelType::POMDP :
+            prismfile << "pomdp\n\n"; 
+            break;
+        case storm::prism::Program::ModelType::PTA :
+            prismfile << "pta\n\n"; 
+            break;
+        case storm::prism::Program::ModelType::SMG  :
+            prismfile << "smg\n\n"; 
+            break;
+        default:
+            prismfile << "mdp\n\n";
+    }
+
+    for(auto boolvar : program.getGlobalBooleanVariables()){
+        for(BetterNode const& node : vertices){
+            bool found = false;
+            if(node.type=="decl gb"){
+                for(auto v : node.def){
+                    if(v.getName() == boolvar.getName()){
+                        prismfile << node.code_segment() << ";\n";
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            if(found) { break;}
+        }
+    }
+    for(auto intvar : program.getGlobalIntegerVariables()){
+        for(BetterNode const& node : vertices){
+            bool found = false;
+            if(node.type=="decl gi"){
+                for(auto v : node.def){
+                    if(v.getName() == intvar.getName()){
+                        prismfile << node.code_segment() << ";\n";
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            if(found) { break;}
+        }
+    }
+    for(auto constant : program.getConstants()){
+        for(BetterNode const& node : vertices){
+            bool found = false;
+            if(node.type=="decl c"){
+                for(auto v : node.def){
+                    if(v.getName() == constant.getName()){
+                        prismfile << node.code_segment() << ";\n";
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            if(found) { break;}
+        }
+    }
+    for(auto formula : program.getFormulas()){
+        for(BetterNode const& node : vertices){
+            bool found = false;
+            if(node.type=="decl f"){
+                for(auto v : node.def){
+                    if(v.getName() == formula.getName()){
+                        prismfile << node.code_segment() << ";\n";
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            if(found) { break;}
+        }
+    }
+    prismfile << "\n";
+    for(storm::prism::Module module : program.getModules()){
+        bool module_relevant = false;
+        //check if this module is in vertices:
+        for(auto const& node : vertices){
+            if(std::string_view(node.module_name) == module.getName()){
+                module_relevant=true;
+                break;
+            }
+        }
+        if(!module_relevant) { continue;}
+        prismfile << "module " << module.getName() << "\n";
+
+        for(storm::prism::BooleanVariable boolvar : module.getBooleanVariables()){
+            for(BetterNode const& node : vertices){
+            bool found = false;
+            if( (node.type=="decl") && (std::string_view(node.module_name) == module.getName()) ){
+                for(auto v : node.def){
+                    if(v.getName() == boolvar.getName()){
+                        prismfile << "  " << node.code_segment() << ";\n";
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            if(found) { break;}
+        }
+        }
+
+        for(storm::prism::IntegerVariable intvar : module.getIntegerVariables()){
+            for(BetterNode const& node : vertices){
+                bool found = false;
+                if( (node.type=="decl") && (std::string_view(node.module_name) == module.getName()) ){
+                    for(auto v : node.def){
+                        if(v.getName() == intvar.getName()){
+                            prismfile << "  " << node.code_segment() << ";\n";
+                            found = true;
+                            break;
+                        }
+                    }
+                }
+                if(found) { break;}
+            }
+        }
+
+        for(storm::prism::Command c : module.getCommands()){
+            // is command relevant?
+            bool command_relevant = false; //relevant if guard is inside nodes
+            for(auto const& node : vertices){
+                if( (node.type == "guard") && (node.identifier == c.getGlobalIndex()) ){
+                    prismfile << "  [" << get_action_of_guard_node(program, node) << "] " << node.code_segment() << " -> ";
+                    command_relevant = true;
+                    break;
+                }
+            }
+            if(!command_relevant) {continue;}
+
+            //are the this commands updates empty in slice? -> updatecounter==0
+            //we need the amount of updates to know if update is followed by '+' or by ';'
+            int update_counter=0;
+            for(storm::prism::Update u : c.getUpdates()){
+                for(auto const& ratenode : vertices){
+                    if( (ratenode.identifier==u.getGlobalIndex()) && (ratenode.type=="rate") ){
+                        update_counter+=1;
+                    }
+                }
+            }
+
+            if(update_counter==0){
+                prismfile << "true;\n";
+                continue;
+            }
+
+            // if we are here, then there are some updates of c contained in the slice 
+            // now we need to take all updates of the original command 
+            update_counter = c.getNumberOfUpdates();
+            
+            // and check if an update is in the slice
+                //if update in slice: write down rate and the assignments contained in the slice
+                //if update not in slice: write down rate and assignment "true"
+
+            for(storm::prism::Update u : c.getUpdates()){
+                bool update_in_slice = false;
+                for(auto const& ratenode : vertices){
+                    if( (ratenode.identifier==u.getGlobalIndex()) && (ratenode.type=="rate") ){
+                        update_counter -=1;
+                        update_in_slice = true;
+                        prismfile << ratenode.code_segment() << ":";
+                        int assgs_left = 0; // we need to know the amount of assignments coming to know which one is the last (is not followed by '&')
+                        for(auto const& assgnode : vertices){
+                            if( (assgnode.identifier==u.getGlobalIndex()) && (assgnode.type=="assignment") ){
+                                assgs_left += 1;
+                            }
+                        }
+                        for(auto const& assgnode : vertices){
+                            if( (assgnode.identifier==u.getGlobalIndex()) && (assgnode.type=="assignment") ){
+                                if(assgs_left > 1){
+                                    prismfile << assgnode.code_segment() << "&";
+                                    assgs_left -=1;
+                                } else if(assgs_left == 1) {
+                                    prismfile << assgnode.code_segment();
+                                }
+                            }
+                        }
+                        
+                    }
+                }
+                if(!update_in_slice){
+                    prismfile << u.getLikelihoodExpression().toString() <<": true";
+                    update_counter -=1;
+                }
+                // add plus or ;?
+                if(update_counter == 0){
+                    prismfile << ";\n"; //end of command
+                } else {
+                    prismfile << " + ";
+                }
+
+            }
+
+        }
+        prismfile << "endmodule\n\n";
+
+        
+    }
+    for(int r = 0; r < program.getRewardModels().size(); r++){
+        bool reward_model_relevant = false;
+        for(auto const& node : vertices){
+            if( (node.type == "reward s" || node.type == "reward a" || node.type == "reward t") && (node.identifier == r) ){
+                if(!reward_model_relevant){
+                    prismfile << "rewards \"" << program.getRewardModels().at(r).getName() << "\"\n";
+                    reward_model_relevant = true;
+                }
+                prismfile << "  " << node.code_segment() << ";\n";
+            }
+        }
+        if(reward_model_relevant){
+            prismfile << "endrewards\n\n";
+        }
+    }
+    for(auto const& node : vertices){
+        if(node.type == "label"){
+            prismfile << node.code_segment() << ";\n";
+        }
+    }
+    if(program.hasInitialConstruct()){
+        for (unsigned k = vertices.size(); k-- != 0; ) { 
+            if(vertices.at(k).type == "init"){
+                prismfile << vertices.at(k).code_segment() << "\n";
+            }
+        }
+    }
+    if(program.specifiesSystemComposition()){
+        // the composition of the modules left in the slice, so they synchronize as in the program
+        std::set<std::string> modules;
+        for(auto const& node : vertices){
+            if(!node.module_name.empty()){ modules.insert(std::string(node.module_name));}
+        }
+        std::shared_ptr<storm::prism::Composition> composition =
+            restrict_composition(program.getSystemCompositionConstruct().getSystemComposition(), modules);
+        if(composition){
+            prismfile << "\nsystem\n  " << *composition << "\nendsystem\n";
+        }
+    }
+}
+
+void write_prism_from_vertices(Vertices const& vertices, storm::prism::Program const& program, std::string path){
+    std::ofstream prismfile;
+    prismfile.open(path);
+    if(prismfile.is_open()){
+        write_prism_from_vertices(vertices, program, prismfile);
+        prismfile.close();
+
+    } else {
+        throw std::invalid_argument( "Unable to open file " + path );
+    }
+    
+
+}
+
+storm::prism::Program program_from_vertices(Vertices const& vertices, storm::prism::Program const& program){
+    PRISL_TRACE_SCOPE("emit", "program construction");
+    // what of the original program is in the slice
+    std::set<std::string> declared; // variables, constants and formulas
+    std::set<std::string> modules;
+    std::map<uint_fast64_t, storm::expressions::Expression> guards; // global command index -> guard of the vertex
+    std::set<uint_fast64_t> rates; // global update indices
+    std::map<uint_fast64_t, std::set<std::string>> assigned; // global update index -> assigned variables
+    std::set<std::string> labels;
+    std::vector<std::vector<storm::prism::StateReward>> state_rewards(program.getRewardModels().size());
+    std::vector<std::vector<storm::prism::StateActionReward>> state_action_rewards(program.getRewardModels().size());
+    std::vector<std::vector<storm::prism::TransitionReward>> transition_rewards(program.getRewardModels().size());
+    bool has_init = false;
+    for(BetterNode const& node : vertices){
+        if(node.type.find("decl") != std::string::npos){
+            for(auto const& v : node.def){
+                declared.insert(v.getName());
+            }
+        } else if(node.type == "guard"){
+            guards.emplace(node.identifier, node.expr);
+        } else if(node.type == "rate"){
+            rates.insert(node.identifier);
+        } else if(node.type == "assignment"){
+            if(node.expr.isInitialized()){ // the 'true' of an empty update assigns nothing
+                assigned[node.identifier].insert(node.var.getName());
+            }
+        } else if(node.type == "label"){
+            labels.insert(std::string(node.name));
+        } else if(node.type == "reward s"){
+            state_rewards.at(node.identifier).emplace_back(node.expr, node.value);
+        } else if(node.type == "reward a"){
+            uint_fast64_t action_index = 0; // storm's index of the silent action
+            if(!node.action.empty()){
+                action_index = program.getActionNameToIndexMapping().at(std::string(node.action));
+            }
+            state_action_rewards.at(node.identifier).emplace_back(action_index, std::string(node.action), node.expr, node.value);
+        } else if(node.type == "reward t"){
+            uint_fast64_t action_index = 0;
+            if(!node.action.empty()){
+                action_index = program.getActionNameToIndexMapping().at(std::string(node.action));
+            }
+            transition_rewards.at(node.identifier).emplace_back(action_index, std::string(node.action), node.expr, node.target, node.value);
+        } else if(node.type == "init"){
+            has_init = true;
+        }
+        if(!node.module_name.empty()){
+            modules.insert(std::string(node.module_name));
+        }
+    }
+
+    std::vector<storm::prism::Constant> constants;
+    for(storm::prism::Constant const& constant : program.getConstants()){
+        if(declared.count(constant.getName())){ constants.push_back(constant);}
+    }
+    std::vector<storm::prism::BooleanVariable> global_booleans;
+    for(storm::prism::BooleanVariable const& boolvar : program.getGlobalBooleanVariables()){
+        if(declared.count(boolvar.getName())){ global_booleans.push_back(boolvar);}
+    }
+    std::vector<storm::prism::IntegerVariable> global_integers;
+    for(storm::prism::IntegerVariable const& intvar : program.getGlobalIntegerVariables()){
+        if(declared.count(intvar.getName())){ global_integers.push_back(intvar);}
+    }
+    std::vector<storm::prism::Formula> formulas;
+    for(storm::prism::Formula const& formula : program.getFormulas()){
+        if(declared.count(formula.getName())){ formulas.push_back(formula);}
+    }
+
+    std::vector<storm::prism::Module> sliced_modules;
+    for(storm::prism::Module const& module : program.getModules()){
+        if(!modules.count(module.getName())){ continue;}
+        std::vector<storm::prism::BooleanVariable> booleans;
+        for(storm::prism::BooleanVariable const& boolvar : module.getBooleanVariables()){
+            if(declared.count(boolvar.getName())){ booleans.push_back(boolvar);}
+        }
+        std::vector<storm::prism::IntegerVariable> integers;
+        for(storm::prism::IntegerVariable const& intvar : module.getIntegerVariables()){
+            if(declared.count(intvar.getName())){ integers.push_back(intvar);}
+        }
+
+        std::vector<storm::prism::Command> commands;
+        for(storm::prism::Command const& c : module.getCommands()){
+            if(!guards.count(c.getGlobalIndex())){ continue;}
+            bool some_update_in_slice = false;
+            for(storm::prism::Update const& u : c.getUpdates()){
+                some_update_in_slice = some_update_in_slice || rates.count(u.getGlobalIndex());
+            }
+
+            std::vector<storm::prism::Update> updates;
+            if(!some_update_in_slice){
+                // written as 'guard -> true;'
+                updates.emplace_back(c.getUpdates().front().getGlobalIndex(), program.getManager().rational(1),
+                                     std::vector<storm::prism::Assignment>(), c.getFilename(), c.getLineNumber());
+            } else {
+                // every update keeps its rate, the ones outside of the slice assign nothing
+                for(storm::prism::Update const& u : c.getUpdates()){
+                    std::vector<storm::prism::Assignment> assignments;
+                    if(rates.count(u.getGlobalIndex())){
+                        std::set<std::string> const& kept = assigned[u.getGlobalIndex()];
+                        for(storm::prism::Assignment const& assg : u.getAssignments()){
+                            if(kept.count(assg.getVariableName())){ assignments.push_back(assg);}
+                        }
+                    }
+                    updates.emplace_back(u.getGlobalIndex(), u.getLikelihoodExpression(), assignments, u.getFilename(), u.getLineNumber());
+                }
+            }
+            commands.emplace_back(c.getGlobalIndex(), c.isMarkovian(), c.getActionIndex(), c.getActionName(), guards.at(c.getGlobalIndex()),
+                                  updates, c.getFilename(), c.getLineNumber());
+        }
+        sliced_modules.emplace_back(module.getName(), booleans, integers, module.getClockVariables(), module.getInvariant(),
+                                    commands, module.getFilename(), module.getLineNumber());
+    }
+
+    std::vector<storm::prism::RewardModel> reward_models;
+    for(int r = 0; r < program.getRewardModels().size(); r++){
+        if(state_rewards.at(r).empty() && state_action_rewards.at(r).empty() && transition_rewards.at(r).empty()){ continue;}
+        storm::prism::RewardModel const& reward_model = program.getRewardModels().at(r);
+        reward_models.emplace_back(reward_model.getName(), state_rewards.at(r), state_action_rewards.at(r),
+                                   transition_rewards.at(r), reward_model.getFilename(), reward_model.getLineNumber());
+    }
+    std::vector<storm::prism::Label> sliced_labels;
+    for(storm::prism::Label const& label : program.getLabels()){
+        if(labels.count(label.getName())){ sliced_labels.push_back(label);}
+    }
+    std::optional<storm::prism::InitialConstruct> initial_construct;
+    if(has_init && program.hasInitialConstruct()){
+        initial_construct = program.getInitialConstruct();
+    }
+    std::optional<storm::prism::SystemCompositionConstruct> composition_construct;
+    if(program.specifiesSystemComposition()){
+        storm::prism::SystemCompositionConstruct const& construct = program.getSystemCompositionConstruct();
+        std::shared_ptr<storm::prism::Composition> composition = restrict_composition(construct.getSystemComposition(), modules);
+        if(composition){
+            composition_construct = storm::prism::SystemCompositionConstruct(composition, construct.getFilename(), construct.getLineNumber());
+        }
+    }
+
+    // like the text output the slice has no players or observations
+    return storm::prism::Program(program.getManager().getSharedPointer(), program.getModelType(), constants, global_booleans,
+                                 global_integers, formulas, std::vector<storm::prism::Player>(), sliced_modules,
+                                 program.getActionNameToIndexMapping(), reward_models, sliced_labels,
+                                 std::vector<storm::prism::ObservationLabel>(), initial_construct,
+                                 composition_construct, true,
+                                 program.getFilename(), program.getLineNumber());
+}
+
+void SliceResult::emit(std::ostream& out) const {
+    write_prism_from_vertices(components, *program, out);
+}
+
+storm::prism::Program SliceResult::to_program() const {
+    return program_from_vertices(components, *program);
+}
+
+uint64_t SliceResult::fingerprint() const {
+    return slice_fingerprint(components, *program);
+}
+
+Slicer::Slicer(std::unique_ptr<storm::prism::Program> loaded_program, std::unique_ptr<CountingResource> upstream,
+               std::unique_ptr<std::pmr::monotonic_buffer_resource> arena, Vertices vertex_table, Options const& options)
+    : loaded_program(std::move(loaded_program)), upstream(std::move(upstream)), arena(std::move(arena)),
+      vertex_table(std::move(vertex_table)), options(options), code_index_once(std::make_unique<std::once_flag>()) {}
+
+Slicer Slicer::load(storm::prism::Program program){
+    return load(std::move(program), Options());
+}
+
+Slicer Slicer::load(storm::prism::Program program, Options const& options, MemoryReport* mem_report){
+    std::unique_ptr<storm::prism::Program> loaded_program = std::make_unique<storm::prism::Program>(std::move(program));
+    std::unique_ptr<CountingResource> upstream = std::make_unique<CountingResource>();
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena = std::make_unique<std::pmr::monotonic_buffer_resource>(upstream.get());
+    Vertices vertex_table = build_vertices_for_program(*loaded_program, arena.get());
+    Slicer slicer(std::move(loaded_program), std::move(upstream), std::move(arena), std::move(vertex_table), options);
+    if(mem_report != nullptr){ mem_report->phase("vertex build");}
+
+    // the code index renders every code segment, it is only built for the first component criterion (code_index)
+    slicer.variable_index = build_variable_index(slicer.vertex_table);
+    slicer.label_index = build_name_index(slicer.vertex_table, "label");
+    slicer.reward_index = build_name_index(slicer.vertex_table, "reward");
+    slicer.module_index = build_module_index(slicer.vertex_table);
+
+    std::unique_ptr<SyncPruner> pruner;
+    if(options.smt){
+        pruner = std::make_unique<SyncPruner>(*slicer.loaded_program);
+    }
+    std::vector<std::vector<int>> graph = build_comp_adj_list(slicer.vertex_table, *slicer.loaded_program, pruner.get(),
+                                                              options.edge_kinds ? &slicer.edge_kind_list : nullptr, options.deps);
+    if(pruner){
+        slicer.sync_checks = pruner->checks;
+        slicer.sync_pruned_pairs = pruner->pruned_pairs;
+    }
+    if(options.edge_kinds){
+        slicer.dependence_graph = graph;
+    }
+    slicer.modules = get_module_nodes(slicer.vertex_table, *slicer.loaded_program);
+    slicer.module_graph = quotient_adj_list(slicer.vertex_table, graph, slicer.modules);
+    slicer.prepare(std::move(graph));
+    if(mem_report != nullptr){ mem_report->phase("edge build");}
+    return slicer;
+}
+
+void Slicer::prepare(std::vector<std::vector<int>> program_order_graph){
+    graph = std::move(program_order_graph);
+    if(options.order != VertexOrder::program){
+        if(order.empty()){
+            order = vertex_order(graph, options.order);
+        }
+        graph = permute_adj_list(graph, order, position);
+    }
+    transposed = transpose_adj_list(graph);
+    if(options.hybrid){
+        hybrid = std::make_unique<HybridAdjacency>(graph);
+        hybrid_transposed = std::make_unique<HybridAdjacency>(transposed);
+        std::vector<std::vector<int>>().swap(graph);
+        std::vector<std::vector<int>>().swap(transposed);
+    }
+}
+
+void Slicer::select_dependences(EdgeKinds mask){
+    if(!options.edge_kinds){
+        throw std::invalid_argument( "selecting dependences needs a slicer loaded with edge kinds" );
+    }
+    std::vector<std::vector<int>> masked = masked_adj_list(dependence_graph, edge_kind_list, mask);
+    module_graph = quotient_adj_list(vertex_table, masked, modules);
+    // the numbering of the searches stays the one of the full graph
+    prepare(std::move(masked));
+}
+
+std::vector<std::vector<int>> Slicer::program_adj_list() const {
+    std::vector<std::vector<int>> program_order_graph(vertex_table.size());
+    for(int k = 0; k < vertex_table.size(); k++){
+        std::vector<int> row = hybrid ? hybrid->row(k) : graph[k];
+        int v = order.empty() ? k : order[k];
+        for(int j : row){
+            program_order_graph[v].push_back(order.empty() ? j : order[j]);
+        }
+    }
+    return program_order_graph;
+}
+
+std::vector<int> Slicer::criteria(std::string const& type, std::vector<std::string> const& crits) const {
+    switch(criterion_index(type)){
+        case 'v': return lookup_criteria(variable_index, type, crits);
+        case 'c': return lookup_criteria(code_index(), type, crits);
+        case 'l': return lookup_criteria(label_index, type, crits);
+        default: return lookup_criteria(reward_index, type, crits);
+    }
+}
+
+VertexIndex const& Slicer::code_index() const {
+    std::call_once(*code_index_once, [this](){ code_segments = build_code_index(vertex_table);});
+    return code_segments;
+}
+
+std::vector<int> Slicer::criteria(storm::jani::Property const& property) const {
+    return property_criteria(property, variable_index, label_index, reward_index, *loaded_program);
+}
+
+std::vector<int> Slicer::to_search_order(std::vector<int> const& criteria) const {
+    if(order.empty()){ return criteria;}
+    std::vector<int> renumbered;
+    renumbered.reserve(criteria.size());
+    for(int c : criteria){
+        renumbered.push_back(position.at(c));
+    }
+    return renumbered;
+}
+
+std::vector<bool> Slicer::search(bool forward, std::vector<int> const& criteria, std::vector<bool> const* within) const {
+    if(hybrid){
+        return (forward ? hybrid_transposed : hybrid)->reach_from(to_search_order(criteria), within);
+    }
+    return reach_from(forward ? transposed : graph, to_search_order(criteria), within);
+}
+
+SliceResult Slicer::result(std::vector<bool> visited) const {
+    if(!order.empty()){
+        std::vector<bool> in_program_order(visited.size(), false);
+        for(int k = 0; k < visited.size(); k++){
+            if(visited[k]){ in_program_order[order[k]] = true;}
+        }
+        visited = std::move(in_program_order);
+    }
+    return collect(std::move(visited));
+}
+
+SliceResult Slicer::slice(std::vector<int> const& criteria, std::vector<bool> const* within) const {
+    if(within == nullptr || order.empty()){
+        return result(search(false, criteria, within));
+    }
+    std::vector<bool> within_search_order(within->size(), false);
+    for(int k = 0; k < within->size(); k++){
+        within_search_order[k] = within->at(order[k]);
+    }
+    return result(search(false, criteria, &within_search_order));
+}
+
+SliceResult Slicer::slice(std::string const& type, std::vector<std::string> const& crits) const {
+    return slice(criteria(type, crits));
+}
+
+SliceResult Slicer::slice_forward(std::vector<int> const& criteria) const {
+    return result(search(true, criteria));
+}
+
+SliceResult Slicer::chop(std::vector<int> const& sources, std::vector<int> const& targets) const {
+    std::vector<bool> forward = search(true, sources);
+    return result(search(false, targets, &forward));
+}
+
+SliceResult Slicer::slice_modules(std::vector<std::string> const& module_names) const {
+    for(std::string const& name : module_names){
+        bool found = std::any_of(modules.begin(), modules.end(), [&name](Module_node const& mod){ return mod.module_name == name;});
+        if(!found){
+            throw std::invalid_argument( "given modulename is not in given program" );
+        }
+    }
+    SliceResult res;
+    res.visited.assign(vertex_table.size(), false);
+    for(Module_node const& module : slice_mdg(module_graph, modules, module_names)){
+        VertexIndex::const_iterator it = module_index.find(module.module_name);
+        if(it == module_index.end()){ continue;} //module without components
+        for(int comp : it->second){
+            res.visited[comp] = true;
+        }
+    }
+    // whole modules, nothing becomes useless
+    for(int v = 0; v < vertex_table.size(); v++){
+        if(res.visited[v]){ res.components.push_back(vertex_table[v]);}
+    }
+    res.program = loaded_program.get();
+    return res;
+}
+
+SliceResult Slicer::collect(std::vector<bool> visited) const {
+    SliceResult res;
+    res.components = collect_slice(vertex_table, visited, *loaded_program);
+    res.visited = std::move(visited);
+    res.program = loaded_program.get();
+    return res;
+}
+
+SliceSession::SliceSession(Slicer const& slicer)
+    : slicer(slicer), visited(slicer.vertex_table.size(), false) {}
+
+std::vector<bool> const& SliceSession::reach_of(int vertex){
+    std::map<int, std::vector<bool>>::iterator it = reach_cache.find(vertex);
+    if(it == reach_cache.end()){
+        it = reach_cache.emplace(vertex, slicer.search(false, {vertex})).first;
+    }
+    return it->second;
+}
+
+void SliceSession::add(std::vector<int> const& criteria){
+    std::vector<int> added; // new criteria in program order
+    for(int c : criteria){
+        if(std::find(seeds.begin(), seeds.end(), c) != seeds.end()){ continue;}
+        seeds.push_back(c);
+        added.push_back(c);
+    }
+    if(slicer.hybrid){
+        // no lists to continue on, the cached reachability of the new criteria is ORed in
+        for(int c : added){
+            std::vector<bool> const& reach = reach_of(c);
+            for(int v = 0; v < visited.size(); v++){
+                if(reach[v] && !visited[v]){
+                    visited[v] = true;
+                    reached += 1;
+                }
+            }
+        }
+        return;
+    }
+    // the search of reach_from, but only through vertices that are not in the slice yet
+    PRISL_TRACE_SCOPE("slice", "slice query");
+    std::vector<int> queue;
+    for(int s : slicer.to_search_order(added)){
+        if(!visited[s]){
+            visited[s] = true;
+            reached += 1;
+            queue.push_back(s);
+        }
+    }
+    for(size_t head = 0; head < queue.size(); head++){
+        for(int j : slicer.graph[queue[head]]){
+            if(!visited[j]){
+                visited[j] = true;
+                reached += 1;
+                queue.push_back(j);
+            }
+        }
+    }
+}
+
+void SliceSession::remove(std::vector<int> const& criteria){
+    size_t before = seeds.size();
+    for(int c : criteria){
+        seeds.erase(std::remove(seeds.begin(), seeds.end(), c), seeds.end());
+    }
+    if(seeds.size() == before){ return;}
+
+    PRISL_TRACE_SCOPE("slice", "slice query");
+    std::fill(visited.begin(), visited.end(), false);
+    reached = 0;
+    for(int c : seeds){
+        std::vector<bool> const& reach = reach_of(c);
+        for(int v = 0; v < visited.size(); v++){
+            if(reach[v] && !visited[v]){
+                visited[v] = true;
+                reached += 1;
+            }
+        }
+    }
+}
+
+SliceResult SliceSession::result() const {
+    return slicer.result(visited);
+}
+
@@ -0,0 +1,252 @@
+#pragma once
+
+// slicing on the component graph and writing slices as PRISM programs
+
+#include "adjacency.h"
+#include "graph.h"
+#include "memory.h"
+
+#include <storm/storage/jani/Property.h>
+
+#include <map>
+#include <memory>
+#include <mutex> // once_flag of the code index
+#include <ostream>
+#include <string>
+#include <vector>
+
+void check_slice_for_useless_commands(Vertices &vertices, storm::prism::Program const& program);
+
+// BFS over the adjacency from the given starting indices. If within is given, only vertices marked there are visited
+std::vector<bool> reach_from(std::vector<std::vector<int>> const& adj_list,
+                             std::vector<int> const& starting_indices,
+                             std::vector<bool> const* within = nullptr);
+
+// reversed dependences: j -> i for every i -> j
+std::vector<std::vector<int>> transpose_adj_list(std::vector<std::vector<int>> const& adj_list);
+
+// renumbering of the vertices for the searches, the program order puts the globals with most of the edges first and
+// lets the edges jump across the whole graph. bfs numbers the vertices in breadth first order over the edges in both
+// directions, rcm is reverse Cuthill-McKee (bfs from a vertex of least degree, neighbours by increasing degree, then
+// reversed), degree puts the vertices of highest degree next to each other at the front
+enum class VertexOrder { program, bfs, rcm, degree };
+VertexOrder parse_vertex_order(std::string const& name);
+
+// order[k] is the vertex that gets number k
+std::vector<int> vertex_order(std::vector<std::vector<int>> const& adj_list, VertexOrder kind);
+
+// the adjacency with vertex order[k] renamed to k, position is filled with the inverse: position[order[k]] == k
+std::vector<std::vector<int>> permute_adj_list(std::vector<std::vector<int>> const& adj_list,
+                                               std::vector<int> const& order,
+                                               std::vector<int> &position);
+
+// the visited vertices in vertex order, without commands that became useless
+Vertices collect_slice(Vertices const& vertices, std::vector<bool> const& visited, storm::prism::Program const& program);
+
+// vertices that survive the constant valuation: guards of commands whose guard does not simplify to false and
+// the rates and assignments of updates whose rate does not simplify to 0, as in instantiate_constants. Dead commands
+// that keep an action in the alphabet of their module (alphabet_commands) keep their guard, they are returned in
+// blocked_commands and have to be passed to block_commands with the slice. The graph of the parametric program is
+// reused, slicing within the mask skips everything that is dead for this valuation
+std::vector<bool> live_vertices(Vertices const& vertices, storm::prism::Program const& program, std::string const& definitions,
+                                std::unordered_set<uint_fast64_t>* blocked_commands = nullptr);
+
+// writes the guards of the given commands in the slice as 'false', so they are emitted as '[a] false -> true;' like
+// the dead commands of instantiate_constants: they keep the action in the alphabet of their module and never fire
+void block_commands(Vertices &slice, std::unordered_set<uint_fast64_t> const& commands, storm::prism::Program const& program);
+
+std::vector<bool> slice_cdg_benchmark(  Vertices const& vertices, 
+                                            std::vector<std::vector<int>> const& adj_list, 
+                                            std::vector<int> const& starting_indices,
+                                            storm::prism::Program const& program);
+
+// vertices for the given criteria of the type, looked up in the index built for it (build_variable_index,
+// build_code_index or build_name_index), throws if one of them is not in the program
+std::vector<int> lookup_criteria(VertexIndex const& index, std::string const& type, std::vector<std::string> const& crits);
+
+// components a property refers to: the declarations of its variables, constants and formulas,
+// the vertices of its labels and of the items of its reward models
+std::vector<int> property_criteria(storm::jani::Property const& property,
+                                   VertexIndex const& variable_index,
+                                   VertexIndex const& label_index,
+                                   VertexIndex const& reward_index,
+                                   storm::prism::Program const& program);
+
+// order independent fingerprint of a slice, for reusing model checking results across versions of a model: the sum
+// of a 64 bit hash per component of its type, module and code without whitespace. Guards also hash their action,
+// rates and assignments the action and guard of their command, assignments also the rate of their update, so moving
+// a component to another command changes the fingerprint. Guards also hash the rates of the updates of their command
+// that are emitted as 'rate: true', and the model type and the system block restricted to the slice are hashed once,
+// so everything the emitted program holds is covered. Vertex numbering and order do not matter
+uint64_t slice_fingerprint(Vertices const& slice, storm::prism::Program const& program);
+// 16 hex digits, as printed and stored in result caches
+std::string format_fingerprint(uint64_t fingerprint);
+
+// properties that are checked on one sliced model
+struct PlannedSlice {
+    std::vector<bool> visited; // union of the slices of its properties
+    size_t size = 0; // visited vertices
+    std::vector<int> members; // indices of the slices merged into it
+};
+
+// merges the slices into as few models as possible: a slice joins a model that already contains it, so equal and
+// nested slices share one. With budget > 0 it also joins the model whose union with it grows the larger of both by
+// at most that fraction (near-equal slices), otherwise it starts a new model. Slices are placed largest first
+std::vector<PlannedSlice> plan_slices(std::vector<std::vector<bool>> const& slices, double budget = 0);
+
+// writes the components as a PRISM program, in the order of the program they were built from
+void write_prism_from_vertices(Vertices const& vertices, storm::prism::Program const& program, std::ostream& prismfile);
+
+void write_prism_from_vertices(Vertices const& vertices, storm::prism::Program const& program, std::string path= "slice.prism");
+
+// the same program as write_prism_from_vertices writes, built from the parts of the original program without a
+// text round trip, so it can go to storm::api::buildSparseModel directly
+storm::prism::Program program_from_vertices(Vertices const& vertices, storm::prism::Program const& program);
+
+// result of one slicing query
+struct SliceResult {
+    Vertices components; // the sliced components in vertex order, without commands that became useless
+    std::vector<bool> visited; // for every vertex of the program if the search reached it
+    storm::prism::Program const* program = nullptr; // the program the slice was taken from
+
+    size_t size() const { return components.size(); }
+    // writes the slice as a PRISM program
+    void emit(std::ostream& out) const;
+    // the slice as a storm program, ready for the model builder
+    storm::prism::Program to_program() const;
+    // see slice_fingerprint
+    uint64_t fingerprint() const;
+};
+
+// in-process slicing of one program: load builds the component graph and the criterion indexes once, after that
+// every query only searches the graph. Code segments are rendered when first needed; the vertex table itself is only
+// rendered once, for the code index of the first component criterion. Queries do not change anything else, so the
+// const methods can be called from several threads at once
+class Slicer {
+public:
+    struct Options {
+        EdgeKinds deps = DEP_DEFAULT; // dependence kinds the slices follow
+        bool smt = false; // prune synchronization edges between guards that cannot hold together
+        VertexOrder order = VertexOrder::program; // numbering of the graph for the searches, results are in program order
+        bool hybrid = false; // search on a HybridAdjacency instead of the adjacency lists, which are released
+        bool edge_kinds = false; // keep the graph of deps in program order with the kinds of its edges
+    };
+
+    static Slicer load(storm::prism::Program program);
+    // with a memory report the peak RSS is recorded after the vertex build and after the edge build
+    static Slicer load(storm::prism::Program program, Options const& options, MemoryReport* mem_report = nullptr);
+
+    // vertices named by the criteria, type is one of v|c|l|r as on the command line. Throws std::invalid_argument
+    // if a criterion is not in the program
+    std::vector<int> criteria(std::string const& type, std::vector<std::string> const& crits) const;
+    // see property_criteria
+    std::vector<int> criteria(storm::jani::Property const& property) const;
+
+    // backward slice: everything the criteria depend on. With within (in program order) only the marked vertices
+    // are visited, f.e. the live_vertices of a constant valuation
+    SliceResult slice(std::vector<int> const& criteria, std::vector<bool> const* within = nullptr) const;
+    SliceResult slice(std::string const& type, std::vector<std::string> const& crits) const;
+    // forward slice: everything that depends on the criteria
+    SliceResult slice_forward(std::vector<int> const& criteria) const;
+    // everything on a dependence path from the sources to the targets
+    SliceResult chop(std::vector<int> const& sources, std::vector<int> const& targets) const;
+    // the modules the given modules depend on in the quotient of the graph by module, with all their components.
+    // Throws std::invalid_argument if a module is not in the program
+    SliceResult slice_modules(std::vector<std::string> const& modules) const;
+    // the slice of vertices marked in program order, f.e. a union of slices
+    SliceResult collect(std::vector<bool> visited) const;
+
+    // searches only the edges of the kinds in mask from now on, needs Options::edge_kinds. Not a query: no other
+    // call may run at the same time, and sessions on the slicer have to start over
+    void select_dependences(EdgeKinds mask);
+
+    storm::prism::Program const& program() const { return *loaded_program;}
+    Vertices const& vertices() const { return vertex_table;}
+    // in the numbering of the searches: search_order()[k] is the vertex of row k, empty for the program order.
+    // Empty with Options::hybrid, the graph is then hybrid_adj_list()
+    std::vector<std::vector<int>> const& adj_list() const { return graph;}
+    HybridAdjacency const* hybrid_adj_list() const { return hybrid.get();}
+    std::vector<int> const& search_order() const { return order;}
+    // the graph of the searches in program order, rebuilt from adj_list() or hybrid_adj_list()
+    std::vector<std::vector<int>> program_adj_list() const;
+    // with Options::edge_kinds: the graph of Options::deps in program order and the kinds of its edges
+    std::vector<std::vector<int>> const& dependences() const { return dependence_graph;}
+    EdgeKindList const& edge_kinds() const { return edge_kind_list;}
+    // code segment -> vertices, built on first use (it renders every code segment), thread-safe
+    VertexIndex const& code_index() const;
+    std::vector<Module_node> const& module_nodes() const { return modules;}
+    std::vector<std::vector<int>> const& module_adj_list() const { return module_graph;}
+    // with Options::smt: guard pairs the solver was asked about and the pairs that can never synchronize
+    size_t smt_checks() const { return sync_checks;}
+    size_t smt_pruned_pairs() const { return sync_pruned_pairs;}
+    // what the vertex table took from the heap
+    CountingResource const& arena_upstream() const { return *upstream;}
+
+private:
+    friend class SliceSession;
+
+    Slicer(std::unique_ptr<storm::prism::Program> loaded_program, std::unique_ptr<CountingResource> upstream,
+           std::unique_ptr<std::pmr::monotonic_buffer_resource> arena, Vertices vertex_table, Options const& options);
+
+    // numbers, transposes and (with Options::hybrid) compresses the graph for the searches, from the program order
+    void prepare(std::vector<std::vector<int>> program_order_graph);
+
+    // reached vertices in the numbering of the searches, over the reversed edges if forward. Criteria are in program
+    // order, within in the numbering of the searches
+    std::vector<bool> search(bool forward, std::vector<int> const& criteria, std::vector<bool> const* within = nullptr) const;
+
+    // criteria in the numbering of the searches, and the reached vertices back in program order
+    std::vector<int> to_search_order(std::vector<int> const& criteria) const;
+    SliceResult result(std::vector<bool> visited) const;
+
+    // heap allocated so their addresses survive moving the slicer, the vertices and results point into them
+    std::unique_ptr<storm::prism::Program> loaded_program;
+    std::unique_ptr<CountingResource> upstream;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+    Vertices vertex_table;
+    Options options;
+    std::unique_ptr<std::once_flag> code_index_once; // heap allocated, once_flag cannot be moved
+    mutable VertexIndex code_segments;
+    VertexIndex variable_index;
+    VertexIndex label_index;
+    VertexIndex reward_index;
+    VertexIndex module_index;
+    std::vector<Module_node> modules;
+    std::vector<std::vector<int>> module_graph;
+    std::vector<std::vector<int>> dependence_graph; // with Options::edge_kinds
+    EdgeKindList edge_kind_list;
+    size_t sync_checks = 0;
+    size_t sync_pruned_pairs = 0;
+    std::vector<std::vector<int>> graph;
+    std::vector<std::vector<int>> transposed; // for forward slices and chops
+    std::vector<int> order; // search number -> vertex, empty for the program order
+    std::vector<int> position; // vertex -> search number
+    std::unique_ptr<HybridAdjacency> hybrid; // with Options::hybrid
+    std::unique_ptr<HybridAdjacency> hybrid_transposed;
+};
+
+// backward slice of a changing set of criteria. Adding criteria continues the search from the new ones only and
+// stops at everything already in the slice. Removing criteria rebuilds the slice from the reachability of every
+// remaining criterion, computed once per criterion and cached. The slicer must outlive the session
+class SliceSession {
+public:
+    explicit SliceSession(Slicer const& slicer);
+
+    // criteria are vertices as returned by Slicer::criteria, ones already in (or not in) the session are ignored
+    void add(std::vector<int> const& criteria);
+    void remove(std::vector<int> const& criteria);
+
+    std::vector<int> const& criteria() const { return seeds;}
+    size_t size() const { return reached;} // vertices in the slice, before removing useless commands
+    SliceResult result() const;
+
+private:
+    // everything one criterion (in program order) reaches, in the numbering of the searches
+    std::vector<bool> const& reach_of(int vertex);
+
+    Slicer const& slicer;
+    std::vector<int> seeds; // in program order, as given
+    std::vector<bool> visited; // in the numbering of the searches
+    size_t reached = 0;
+    std::map<int, std::vector<bool>> reach_cache; // by criterion in program order
+};
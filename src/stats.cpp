@@ -0,0 +1,207 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <string>
+
+std::vector<int> strongly_connected_components(std::vector<std::vector<int>> const& adj_list, int &count){
+    int n = adj_list.size();
+    std::vector<int> index(n, -1);
+    std::vector<int> lowlink(n, 0);
+    std::vector<int> component(n, -1);
+    std::vector<bool> on_stack(n, false);
+    std::vector<int> stack;
+    std::vector<std::pair<int, int>> call_stack; // vertex and its next edge, instead of recursion
+    int next_index = 0;
+    count = 0;
+
+    auto visit = [&](int v){
+        index[v] = next_index;
+        lowlink[v] = next_index;
+        next_index++;
+        stack.push_back(v);
+        on_stack[v] = true;
+        call_stack.emplace_back(v, 0);
+    };
+
+    for(int root = 0; root < n; root++){
+        if(index[root] != -1){ continue;}
+        visit(root);
+        while(!call_stack.empty()){
+            int v = call_stack.back().first;
+            if(call_stack.back().second < adj_list[v].size()){
+                int w = adj_list[v][call_stack.back().second++];
+                if(index[w] == -1){
+                    visit(w);
+                } else if(on_stack[w]){
+                    lowlink[v] = std::min(lowlink[v], index[w]);
+                }
+                continue;
+            }
+            // all edges of v done
+            if(lowlink[v] == index[v]){
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[w] = false;
+                    component[w] = count;
+                } while(w != v);
+                count++;
+            }
+            call_stack.pop_back();
+            if(!call_stack.empty()){
+                int parent = call_stack.back().first;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[v]);
+            }
+        }
+    }
+    return component;
+}
+
+GraphStats graph_stats(Vertices const& vertices,
+                       std::vector<std::vector<int>> const& adj_list,
+                       EdgeKindList const& edge_kinds,
+                       int top_hubs){
+    GraphStats stats;
+    stats.nodes = vertices.size();
+    stats.in_degrees.assign(vertices.size(), 0);
+    stats.out_degrees.assign(vertices.size(), 0);
+
+    std::set<std::string> globals;
+    for(BetterNode const& node : vertices){
+        if(node.type == "decl gb" || node.type == "decl gi"){
+            for(auto const& v : node.def){
+                globals.insert(v.getName());
+            }
+        }
+    }
+
+    for(int i = 0; i < adj_list.size(); i++){
+        stats.out_degrees[i] = adj_list[i].size();
+        stats.edges += adj_list[i].size();
+        for(int k = 0; k < adj_list[i].size(); k++){
+            int j = adj_list[i][k];
+            stats.in_degrees[j] += 1;
+            EdgeKinds kinds = edge_kinds[i][k];
+            for(int bit = 0; bit < 6; bit++){
+                if(kinds & (1 << bit)){ stats.edges_by_kind[bit] += 1;}
+            }
+            if(vertices.at(i).type == "decl f" || vertices.at(j).type == "decl f"){
+                stats.formula_edges += 1;
+            }
+            if(kinds & DEP_DATA){
+                // i reads a global that j defines
+                bool global = false;
+                for(Variable varj : vertices.at(j).def){
+                    if(!globals.count(varj.getName())){ continue;}
+                    for(Variable vari : vertices.at(i).ref){
+                        if(vari.getName() == varj.getName()){
+                            global = true;
+                            break;
+                        }
+                    }
+                    if(global){ break;}
+                }
+                stats.global_edges += global;
+            }
+        }
+    }
+
+    std::vector<int> component = strongly_connected_components(adj_list, stats.sccs);
+    std::vector<std::vector<int>> members(stats.sccs);
+    for(int v = 0; v < component.size(); v++){
+        members[component[v]].push_back(v);
+    }
+    // edges between components go to lower numbers, so the depths of the targets are known first
+    std::vector<size_t> depth(stats.sccs, 1);
+    for(int c = 0; c < stats.sccs; c++){
+        stats.scc_sizes[members[c].size()] += 1;
+        for(int v : members[c]){
+            for(int w : adj_list[v]){
+                if(component[w] != c){
+                    depth[c] = std::max(depth[c], depth[component[w]] + 1);
+                }
+            }
+        }
+        stats.dag_depth = std::max(stats.dag_depth, depth[c]);
+    }
+
+    std::vector<int> order(vertices.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&stats](int a, int b){ return stats.in_degrees[a] > stats.in_degrees[b];});
+    for(int k = 0; k < std::min<int>(top_hubs, order.size()); k++){
+        stats.hubs.emplace_back(order[k], stats.in_degrees[order[k]]);
+    }
+    return stats;
+}
+
+// min, median, mean, max and a histogram in power of two buckets
+void print_degrees(std::vector<size_t> degrees, std::ostream& out){
+    if(degrees.empty()){
+        out << "-\n";
+        return;
+    }
+    std::sort(degrees.begin(), degrees.end());
+    double mean = std::accumulate(degrees.begin(), degrees.end(), 0.0) / degrees.size();
+    out << "min " << degrees.front() << ", median " << degrees[degrees.size() / 2] << ", mean " << mean
+        << ", max " << degrees.back() << "\n";
+    std::map<size_t, size_t> buckets; // lower bound -> vertices
+    for(size_t degree : degrees){
+        size_t lower = 0;
+        if(degree > 0){
+            lower = 1;
+            while(lower * 2 <= degree){ lower *= 2;}
+        }
+        buckets[lower] += 1;
+    }
+    out << "           ";
+    for(auto const& bucket : buckets){
+        out << " ";
+        if(bucket.first <= 1){
+            out << bucket.first;
+        } else {
+            out << bucket.first << "-" << bucket.first * 2 - 1;
+        }
+        out << ": " << bucket.second;
+    }
+    out << "\n";
+}
+
+void GraphStats::print(Vertices const& vertices, std::ostream& out) const {
+    double share = edges == 0 ? 0 : 100.0 / edges;
+    out << "Graph statistics:\n";
+    out << "      nodes: " << nodes << "\n";
+    out << "      edges: " << edges << " (density " << (nodes == 0 ? 0 : static_cast<double>(edges) / (nodes * nodes)) << ")\n";
+    // what the graph would take as adjacency lists or as a bit matrix
+    out << "      adjacency bytes: lists " << edges * sizeof(int) + nodes * sizeof(std::vector<int>)
+        << ", bit matrix " << nodes * ((nodes + 63) / 64) * sizeof(uint64_t) << "\n";
+    out << "      out-degree: ";
+    print_degrees(out_degrees, out);
+    out << "      in-degree: ";
+    print_degrees(in_degrees, out);
+
+    const char* kind_names[] = {"ar", "gg", "ag", "data", "di", "ra"};
+    out << "      edges by kind:";
+    for(int bit = 0; bit < 6; bit++){
+        out << " " << kind_names[bit] << "=" << edges_by_kind[bit];
+    }
+    out << "\n";
+    out << "      edges on global variables: " << global_edges << " (" << global_edges * share << "%)\n";
+    out << "      edges of formulas: " << formula_edges << " (" << formula_edges * share << "%)\n";
+
+    out << "      sccs: " << sccs << ", sizes:";
+    for(auto const& size : scc_sizes){
+        out << " " << size.first << "x" << size.second;
+    }
+    out << "\n";
+    out << "      condensation depth: " << dag_depth << "\n";
+
+    out << "      hubs by fan-in:\n";
+    for(auto const& hub : hubs){
+        BetterNode const& node = vertices.at(hub.first);
+        out << "          " << hub.second << "  " << node.type << "  " << (node.module_name.empty() ? std::string_view("-") : std::string_view(node.module_name))
+            << "  " << node.code_segment() << "\n";
+    }
+}
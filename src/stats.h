@@ -0,0 +1,36 @@
+#pragma once
+
+// structure of the component graph: degrees, edge kinds, strongly connected components and hubs (stats)
+
+#include "graph.h"
+
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+// strongly connected components with Tarjan's algorithm, component of every vertex. Components are numbered in the
+// order Tarjan finishes them, so an edge between two components always goes to the lower number
+std::vector<int> strongly_connected_components(std::vector<std::vector<int>> const& adj_list, int &count);
+
+struct GraphStats {
+    size_t nodes = 0;
+    size_t edges = 0;
+    std::vector<size_t> in_degrees; // per vertex, edges ending in it (fan-in)
+    std::vector<size_t> out_degrees; // per vertex, dependences of it (fan-out)
+    size_t edges_by_kind[6] = {}; // ar, gg, ag, data, di, ra; an edge of several kinds counts for each
+    size_t global_edges = 0; // data edges on a global variable
+    size_t formula_edges = 0; // edges from or to a formula definition
+    int sccs = 0;
+    std::map<size_t, size_t> scc_sizes; // size -> number of components
+    size_t dag_depth = 0; // components on the longest path of the condensation
+    std::vector<std::pair<int, size_t>> hubs; // vertex and fan-in, highest fan-in first
+
+    void print(Vertices const& vertices, std::ostream& out) const;
+};
+
+// the edge kinds must belong to adj_list, as filled by build_comp_adj_list
+GraphStats graph_stats(Vertices const& vertices,
+                       std::vector<std::vector<int>> const& adj_list,
+                       EdgeKindList const& edge_kinds,
+                       int top_hubs = 10);
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h> // getpid for the trace
+
+// Chrome trace-event spans of the pipeline (chrome://tracing or ui.perfetto.dev), written by --trace FILE.
+// Disabled at runtime a span is a single branch on a global flag, built with PRISL_TRACE=0 it is gone entirely
+#ifndef PRISL_TRACE
+#define PRISL_TRACE 1
+#endif
+
+class Tracer {
+public:
+    static Tracer& instance(){
+        static Tracer tracer;
+        return tracer;
+    }
+
+    bool enabled = false;
+
+    // small per thread ids instead of the opaque std::thread::id
+    static int thread_id(){
+        static std::atomic<int> next_id(0);
+        thread_local int id = next_id++;
+        return id;
+    }
+
+    long long now_us() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    void record(std::string name, char const* category, long long begin_us, long long end_us){
+        std::lock_guard<std::mutex> lock(events_mutex);
+        events.push_back(Event{std::move(name), category, begin_us, end_us - begin_us, thread_id()});
+    }
+
+    void write(std::string const& path){
+        if(!enabled){ return;}
+        std::ofstream tracefile(path);
+        if(!tracefile.is_open()){
+            std::cout << "Unable to open file" <<std::endl;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(events_mutex);
+        tracefile << "{\"traceEvents\": [";
+        for(size_t i = 0; i < events.size(); i++){
+            Event const& event = events.at(i);
+            tracefile << (i == 0 ? "\n" : ",\n") << "  {\"name\": \"";
+            for(char c : event.name){
+                if(c == '"' || c == '\\'){ tracefile << '\\';}
+                tracefile << c;
+            }
+            tracefile << "\", \"cat\": \"" << event.category << "\", \"ph\": \"X\", \"ts\": " << event.begin_us
+                      << ", \"dur\": " << event.duration_us << ", \"pid\": " << getpid() << ", \"tid\": " << event.thread << "}";
+        }
+        tracefile << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    }
+
+private:
+    struct Event {
+        std::string name;
+        char const* category;
+        long long begin_us;
+        long long duration_us;
+        int thread;
+    };
+
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::mutex events_mutex;
+    std::vector<Event> events;
+};
+
+
+// records the time from construction to end() or destruction, the detail (f.e. a module name) is appended to the name
+class TraceSpan {
+public:
+    TraceSpan(char const* category, char const* name, std::string_view detail = {}){
+        if(__builtin_expect(Tracer::instance().enabled, 0)){
+            active = true;
+            this->category = category;
+            this->name = name;
+            if(!detail.empty()){
+                this->name += " ";
+                this->name += detail;
+            }
+            begin_us = Tracer::instance().now_us();
+        }
+    }
+
+    void end(){
+        if(active){
+            Tracer::instance().record(std::move(name), category, begin_us, Tracer::instance().now_us());
+            active = false;
+        }
+    }
+
+    ~TraceSpan(){ end();}
+
+private:
+    bool active = false;
+    char const* category = nullptr;
+    std::string name;
+    long long begin_us = 0;
+};
+
+#if PRISL_TRACE
+#define PRISL_TRACE_CONCAT_(a, b) a##b
+#define PRISL_TRACE_CONCAT(a, b) PRISL_TRACE_CONCAT_(a, b)
+// span until the end of the enclosing scope
+#define PRISL_TRACE_SCOPE(...) TraceSpan PRISL_TRACE_CONCAT(prisl_trace_span_, __LINE__)(__VA_ARGS__)
+// named span, closed with PRISL_TRACE_END(span) or at the end of the scope
+#define PRISL_TRACE_BEGIN(span, ...) TraceSpan span(__VA_ARGS__)
+#define PRISL_TRACE_END(span) span.end()
+#else
+#define PRISL_TRACE_SCOPE(...) ((void)0)
+#define PRISL_TRACE_BEGIN(span, ...) ((void)0)
+#define PRISL_TRACE_END(span) ((void)0)
+#endif
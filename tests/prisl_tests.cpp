@@ -0,0 +1,115 @@
+// checks of the slicing library on real models, run by ctest: prisl-tests TEST MODEL...
+
+#include "slicer.h"
+
+#include <storm-parsers/parser/PrismParser.h>
+#include <storm/storage/prism/Program.h>
+#include <storm/utility/initialize.h>
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// sessions on a renumbered graph, with and without hybrid rows, where they translate between the program order and
+// the numbering of the searches: adds and removes criteria spread over the program and compares the session after
+// every step with Slicer::slice of its criteria
+bool check_session(std::string const& path){
+    storm::prism::Program program = storm::parser::PrismParser::parse(path, true);
+    for(bool hybrid : {false, true}){
+        Slicer::Options options;
+        options.order = VertexOrder::rcm;
+        options.hybrid = hybrid;
+        Slicer slicer = Slicer::load(program, options);
+
+        // up to 16 criteria: add half, add the rest, remove every second one
+        int n = slicer.vertices().size();
+        int count = std::min(n, 16);
+        std::vector<int> crits;
+        for(int k = 0; k < count; k++){
+            crits.push_back(k * n / count);
+        }
+        std::vector<int> first_half(crits.begin(), crits.begin() + crits.size() / 2);
+        std::vector<int> every_second;
+        for(int k = 0; k < crits.size(); k += 2){
+            every_second.push_back(crits[k]);
+        }
+
+        SliceSession session(slicer);
+        auto matches = [&](){ return session.result().visited == slicer.slice(session.criteria()).visited;};
+        session.add(first_half);
+        bool passed = matches();
+        session.add(crits);
+        passed = passed && matches();
+        session.remove(every_second);
+        passed = passed && matches();
+        if(!passed){
+            std::cout << "session differs from the slicer" << (hybrid ? " on the hybrid graph" : "") << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// synchronization pruning keeps blocking: in the --smt slice of every guard, every other module with a command on
+// the action of a sliced command keeps one of them, also if none of them can ever hold together with it
+bool check_blocking(std::string const& path){
+    storm::prism::Program program = storm::parser::PrismParser::parse(path, true);
+    Slicer::Options options;
+    options.smt = true;
+    Slicer slicer = Slicer::load(program, options);
+    std::unordered_map<uint_fast64_t, std::string> action_of = program.buildCommandIndexToActionNameMap();
+
+    for(int v = 0; v < slicer.vertices().size(); v++){
+        if(slicer.vertices().at(v).type != "guard"){ continue;}
+        SliceResult slice = slicer.slice({v});
+        std::set<std::pair<std::string, std::string>> kept; // module, action of the sliced commands
+        for(BetterNode const& node : slice.components){
+            if(node.type == "guard"){
+                kept.emplace(std::string(node.module_name), action_of.at(node.identifier));
+            }
+        }
+        for(std::pair<std::string, std::string> const& command : kept){
+            if(command.second.empty()){ continue;}
+            for(storm::prism::Module const& module : program.getModules()){
+                bool has_action = std::any_of(module.getCommands().begin(), module.getCommands().end(),
+                                              [&](storm::prism::Command const& c){ return c.getActionName() == command.second;});
+                if(has_action && !kept.count(std::make_pair(module.getName(), command.second))){
+                    std::cout << "slice of " << slicer.vertices().at(v).code_segment() << " lost the [" << command.second
+                              << "] commands of " << module.getName() << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]){
+    storm::utility::setUp();
+    storm::settings::initializeAll("prisl-tests", "prisl-tests");
+
+    if(argc < 3){
+        std::cout << "usage: prisl-tests session|blocking MODEL..." << std::endl;
+        return 2;
+    }
+    std::string test = argv[1];
+    int failures = 0;
+    for(int i = 2; i < argc; i++){
+        bool passed;
+        if(test == "session"){
+            passed = check_session(argv[i]);
+        } else if(test == "blocking"){
+            passed = check_blocking(argv[i]);
+        } else {
+            std::cout << "unknown test: " << test << std::endl;
+            return 2;
+        }
+        std::cout << (passed ? "PASSED " : "FAILED ") << test << " " << argv[i] << std::endl;
+        failures += passed ? 0 : 1;
+    }
+    return failures == 0 ? 0 : 1;
+}